@@ -0,0 +1,37 @@
+#ifndef NAMEHASH_H
+#define NAMEHASH_H
+
+#include <cstdint>
+#include <string>
+
+using namespace std;
+
+/**
+ * @file NameHash.h
+ * @brief Internal 64-bit hash of a person's name, used by the MinHash sketches and
+ * the shard partitioning.
+ */
+
+/**
+ * @brief Hashes a person's name.
+ *
+ * FNV-1a followed by the splitmix64 finalizer, so that similar names ("P1", "P2",
+ * ...) still land on unrelated, uniformly spread 64-bit values.
+ */
+inline uint64_t hashName(const string &name)
+{
+    uint64_t h = 14695981039346656037ULL;
+    for (size_t i = 0; i < name.size(); i++)
+    {
+        h ^= (unsigned char)name[i];
+        h *= 1099511628211ULL;
+    }
+    h ^= h >> 30;
+    h *= 0xbf58476d1ce4e5b9ULL;
+    h ^= h >> 27;
+    h *= 0x94d049bb133111ebULL;
+    h ^= h >> 31;
+    return h;
+}
+
+#endif // NAMEHASH_H
@@ -0,0 +1,1004 @@
+#include "ShardedSocialNetwork.h"
+#include "NameHash.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <unordered_map>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// ==============================
+// Wire Protocol
+// ==============================
+
+/**
+ * @brief Request types understood by the shard workers.
+ *
+ * Every request gets exactly one reply, except SHUTDOWN. People are named by
+ * global ID except where noted; ID pairs travel as a flat list (first, second, ...).
+ */
+enum ShardRequest
+{
+    ADD_PEOPLE,        ///< names -> ack
+    LOOKUP,            ///< names -> one ID per name
+    NAMES_OF,          ///< owned IDs -> one name per ID
+    ADD_HALF_EDGES,    ///< (owned ID, friend ID) pairs -> ack
+    REMOVE_HALF_EDGES, ///< (owned ID, friend ID) pairs -> ack
+    DELETE_PERSON,     ///< name -> ID (UNKNOWN_PERSON if absent), former friend IDs
+    ARE_FRIENDS,       ///< owned ID, other ID -> byte
+    FRIENDS_OF,        ///< owned ID -> friend IDs
+    TWO_HOP_COUNTS,    ///< person ID, owned friend IDs -> (candidate ID, count) pairs
+    BFS_BEGIN,         ///< target ID -> ack
+    BFS_VISIT,         ///< (owned ID, parent ID) pairs -> next frontier size, target-found byte
+    BFS_EXPAND,        ///< (nothing) -> one (ID, parent ID) pair list per shard
+    BFS_PARENT,        ///< owned ID -> parent ID
+    SHUTDOWN           ///< (nothing) -> no reply, worker exits
+};
+
+static const uint32_t UNKNOWN_PERSON = 0xFFFFFFFFu; ///< ID of a name that is not in the network
+
+/**
+ * @brief Builds a request or reply payload.
+ */
+class MessageWriter
+{
+    string data; ///< Encoded bytes
+
+public:
+    void putByte(uint8_t value)
+    {
+        data.push_back((char)value);
+    }
+
+    void putCount(uint32_t value)
+    {
+        data.append((const char *)&value, sizeof(value));
+    }
+
+    void putString(const string &value)
+    {
+        putCount((uint32_t)value.size());
+        data.append(value);
+    }
+
+    void putStrings(const vector<string> &values)
+    {
+        putCount((uint32_t)values.size());
+        for (size_t i = 0; i < values.size(); i++)
+        {
+            putString(values[i]);
+        }
+    }
+
+    void putIds(const vector<uint32_t> &values)
+    {
+        putCount((uint32_t)values.size());
+        if (!values.empty())
+            data.append((const char *)&values[0], values.size() * sizeof(uint32_t));
+    }
+
+    const string &payload() const
+    {
+        return data;
+    }
+};
+
+/**
+ * @brief Decodes a payload built by MessageWriter.
+ * @throws runtime_error if the payload is shorter than what is read from it.
+ */
+class MessageReader
+{
+    const string &data; ///< Encoded bytes
+    size_t position;    ///< Offset of the next unread byte
+
+    void need(size_t bytes)
+    {
+        if (data.size() - position < bytes)
+            throw runtime_error("truncated shard message");
+    }
+
+public:
+    explicit MessageReader(const string &data) : data(data), position(0) {}
+
+    uint8_t getByte()
+    {
+        need(1);
+        return (uint8_t)data[position++];
+    }
+
+    uint32_t getCount()
+    {
+        uint32_t value;
+        need(sizeof(value));
+        memcpy(&value, data.data() + position, sizeof(value));
+        position += sizeof(value);
+        return value;
+    }
+
+    string getString()
+    {
+        uint32_t size = getCount();
+        need(size);
+        string value = data.substr(position, size);
+        position += size;
+        return value;
+    }
+
+    vector<string> getStrings()
+    {
+        uint32_t count = getCount();
+        vector<string> values;
+        values.reserve(min<uint32_t>(count, (uint32_t)(data.size() - position) / sizeof(uint32_t)));
+        for (uint32_t i = 0; i < count; i++)
+        {
+            values.push_back(getString());
+        }
+        return values;
+    }
+
+    vector<uint32_t> getIds()
+    {
+        uint32_t count = getCount();
+        need((size_t)count * sizeof(uint32_t));
+        vector<uint32_t> values(count);
+        if (count > 0)
+            memcpy(&values[0], data.data() + position, (size_t)count * sizeof(uint32_t));
+        position += (size_t)count * sizeof(uint32_t);
+        return values;
+    }
+};
+
+#ifdef MSG_NOSIGNAL
+static const int SEND_FLAGS = MSG_NOSIGNAL; // a dead peer is reported as EPIPE instead of killing us
+#else
+static const int SEND_FLAGS = 0; // SO_NOSIGPIPE is set on the socket instead
+#endif
+
+/**
+ * @brief Sends a length-prefixed message, retrying partial and interrupted writes.
+ * @throws runtime_error if the peer has gone away.
+ */
+static void sendMessage(int socket, const string &payload)
+{
+    uint32_t size = (uint32_t)payload.size();
+    string frame((const char *)&size, sizeof(size));
+    frame.append(payload);
+
+    size_t sent = 0;
+    while (sent < frame.size())
+    {
+        ssize_t written = send(socket, frame.data() + sent, frame.size() - sent, SEND_FLAGS);
+        if (written < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            throw runtime_error(string("lost connection to shard: ") + strerror(errno));
+        }
+        sent += (size_t)written;
+    }
+}
+
+/**
+ * @brief Reads exactly size bytes, retrying partial and interrupted reads.
+ * @return False if the peer closed the connection first.
+ */
+static bool receiveBytes(int socket, char *buffer, size_t size)
+{
+    size_t received = 0;
+    while (received < size)
+    {
+        ssize_t got = recv(socket, buffer + received, size - received, 0);
+        if (got < 0 && errno == EINTR)
+            continue;
+        if (got <= 0)
+            return false;
+        received += (size_t)got;
+    }
+    return true;
+}
+
+/**
+ * @brief Receives one length-prefixed message.
+ * @return False if the peer closed the connection.
+ */
+static bool receiveMessage(int socket, string &payload)
+{
+    uint32_t size;
+    if (!receiveBytes(socket, (char *)&size, sizeof(size)))
+        return false;
+    payload.resize(size);
+    return size == 0 || receiveBytes(socket, &payload[0], size);
+}
+
+/**
+ * @brief Shard that a new person is placed on.
+ */
+static int ownerOf(const string &name, int shardCount)
+{
+    return (int)(hashName(name) % (uint64_t)shardCount);
+}
+
+// ==============================
+// Shard Worker
+// ==============================
+
+/**
+ * @brief Everything one worker process holds.
+ *
+ * Owned people are numbered locally in order of arrival; deleted people keep their
+ * number (marked not alive) so that IDs are never reused.
+ */
+struct ShardState
+{
+    uint32_t index; ///< This shard's number
+    uint32_t count; ///< Total number of shards
+
+    unordered_map<string, uint32_t> localIds; ///< Name -> local number of every living owned person
+    vector<string> names;                     ///< Local number -> name
+    vector<vector<uint32_t>> friends;         ///< Local number -> global IDs of their friends
+    vector<char> alive;                       ///< Local number -> 0 once deleted
+
+    vector<uint32_t> parent;       ///< BFS: local number -> global ID of whoever reached them
+    vector<uint32_t> reachedIn;    ///< BFS: local number -> search that reached them (stale if not current)
+    uint32_t search;               ///< BFS: number of the current search
+    vector<uint32_t> frontier;     ///< BFS: local numbers on the current level
+    vector<uint32_t> nextFrontier; ///< BFS: local numbers reached for the next level
+    uint32_t target;               ///< BFS: global ID being searched for
+    bool targetFound;              ///< BFS: true once this shard has reached the target
+
+    uint32_t globalId(uint32_t local) const
+    {
+        return local * count + index;
+    }
+
+    /**
+     * @brief Local number of a living owned person.
+     * @return False if the ID does not name one.
+     */
+    bool localOf(uint32_t id, uint32_t &local) const
+    {
+        local = id / count;
+        return id % count == index && local < names.size() && alive[local];
+    }
+
+    /**
+     * @brief Marks an owned person as reached by the BFS.
+     */
+    void visit(uint32_t local, uint32_t from)
+    {
+        if (!alive[local] || reachedIn[local] == search)
+            return;
+        reachedIn[local] = search;
+        parent[local] = from;
+        nextFrontier.push_back(local);
+        if (globalId(local) == target)
+            targetFound = true;
+    }
+
+    /**
+     * @brief Applies (owned ID, friend ID) pairs to the friend lists.
+     */
+    void applyHalfEdges(const vector<uint32_t> &pairs, bool adding)
+    {
+        for (size_t i = 0; i + 1 < pairs.size(); i += 2)
+        {
+            uint32_t local;
+            if (!localOf(pairs[i], local))
+                continue;
+            vector<uint32_t> &list = friends[local];
+            vector<uint32_t>::iterator pos = find(list.begin(), list.end(), pairs[i + 1]);
+            if (adding && pos == list.end())
+                list.push_back(pairs[i + 1]);
+            else if (!adding && pos != list.end())
+                list.erase(pos);
+        }
+    }
+
+    /**
+     * @brief Handles one request.
+     * @param request Payload received from the coordinator.
+     * @param reply Receives the reply payload.
+     * @return False for SHUTDOWN.
+     */
+    bool handle(const string &request, MessageWriter &reply)
+    {
+        MessageReader in(request);
+        uint32_t local;
+        switch (in.getByte())
+        {
+        case ADD_PEOPLE:
+        {
+            vector<string> added = in.getStrings();
+            for (size_t i = 0; i < added.size(); i++)
+            {
+                if (!localIds.insert(make_pair(added[i], (uint32_t)names.size())).second)
+                    continue;
+                names.push_back(added[i]);
+                friends.push_back(vector<uint32_t>());
+                alive.push_back(1);
+                parent.push_back(UNKNOWN_PERSON);
+                reachedIn.push_back(0);
+            }
+            break;
+        }
+
+        case LOOKUP:
+        {
+            vector<string> wanted = in.getStrings();
+            vector<uint32_t> ids(wanted.size(), UNKNOWN_PERSON);
+            for (size_t i = 0; i < wanted.size(); i++)
+            {
+                unordered_map<string, uint32_t>::iterator it = localIds.find(wanted[i]);
+                if (it != localIds.end())
+                    ids[i] = globalId(it->second);
+            }
+            reply.putIds(ids);
+            break;
+        }
+
+        case NAMES_OF:
+        {
+            vector<uint32_t> ids = in.getIds();
+            vector<string> found(ids.size());
+            for (size_t i = 0; i < ids.size(); i++)
+            {
+                if (localOf(ids[i], local))
+                    found[i] = names[local];
+            }
+            reply.putStrings(found);
+            break;
+        }
+
+        case ADD_HALF_EDGES:
+            applyHalfEdges(in.getIds(), true);
+            break;
+
+        case REMOVE_HALF_EDGES:
+            applyHalfEdges(in.getIds(), false);
+            break;
+
+        case DELETE_PERSON:
+        {
+            unordered_map<string, uint32_t>::iterator it = localIds.find(in.getString());
+            if (it == localIds.end())
+            {
+                reply.putCount(UNKNOWN_PERSON);
+                reply.putIds(vector<uint32_t>());
+                break;
+            }
+            local = it->second;
+            reply.putCount(globalId(local));
+            reply.putIds(friends[local]);
+            localIds.erase(it);
+            alive[local] = 0;
+            vector<uint32_t>().swap(friends[local]);
+            break;
+        }
+
+        case ARE_FRIENDS:
+        {
+            uint32_t person = in.getCount();
+            uint32_t other = in.getCount();
+            bool linked = localOf(person, local) && find(friends[local].begin(), friends[local].end(), other) != friends[local].end();
+            reply.putByte(linked ? 1 : 0);
+            break;
+        }
+
+        case FRIENDS_OF:
+            reply.putIds(localOf(in.getCount(), local) ? friends[local] : vector<uint32_t>());
+            break;
+
+        case TWO_HOP_COUNTS:
+        {
+            uint32_t person = in.getCount();
+            vector<uint32_t> owned = in.getIds();
+            unordered_map<uint32_t, uint32_t> counts;
+            for (size_t i = 0; i < owned.size(); i++)
+            {
+                if (!localOf(owned[i], local))
+                    continue;
+                for (size_t j = 0; j < friends[local].size(); j++)
+                {
+                    if (friends[local][j] != person)
+                        counts[friends[local][j]]++;
+                }
+            }
+            vector<uint32_t> pairs;
+            pairs.reserve(counts.size() * 2);
+            for (unordered_map<uint32_t, uint32_t>::iterator it = counts.begin(); it != counts.end(); ++it)
+            {
+                pairs.push_back(it->first);
+                pairs.push_back(it->second);
+            }
+            reply.putIds(pairs);
+            break;
+        }
+
+        case BFS_BEGIN:
+            target = in.getCount();
+            targetFound = false;
+            search++;
+            frontier.clear();
+            nextFrontier.clear();
+            break;
+
+        case BFS_VISIT:
+        {
+            vector<uint32_t> pairs = in.getIds();
+            for (size_t i = 0; i + 1 < pairs.size(); i += 2)
+            {
+                if (localOf(pairs[i], local))
+                    visit(local, pairs[i + 1]);
+            }
+            // Closes the level: everyone reached by the last expansion forms the new frontier
+            frontier.swap(nextFrontier);
+            nextFrontier.clear();
+            reply.putCount((uint32_t)frontier.size());
+            reply.putByte(targetFound ? 1 : 0);
+            break;
+        }
+
+        case BFS_EXPAND:
+        {
+            // Owned neighbors are visited on the spot; the rest are batched per owner
+            vector<vector<uint32_t>> outgoing(count);
+            for (size_t i = 0; i < frontier.size(); i++)
+            {
+                uint32_t from = globalId(frontier[i]);
+                const vector<uint32_t> &list = friends[frontier[i]];
+                for (size_t j = 0; j < list.size(); j++)
+                {
+                    uint32_t owner = list[j] % count;
+                    if (owner == index)
+                    {
+                        visit(list[j] / count, from);
+                    }
+                    else
+                    {
+                        outgoing[owner].push_back(list[j]);
+                        outgoing[owner].push_back(from);
+                    }
+                }
+            }
+            for (uint32_t d = 0; d < count; d++)
+            {
+                reply.putIds(outgoing[d]);
+            }
+            break;
+        }
+
+        case BFS_PARENT:
+        {
+            uint32_t id = in.getCount();
+            reply.putCount(localOf(id, local) && reachedIn[local] == search ? parent[local] : UNKNOWN_PERSON);
+            break;
+        }
+
+        case SHUTDOWN:
+        default:
+            return false;
+        }
+        return true;
+    }
+};
+
+void ShardedSocialNetwork::workerMain(int socket, int shardIndex, int shardCount)
+{
+    ShardState state;
+    state.index = (uint32_t)shardIndex;
+    state.count = (uint32_t)shardCount;
+    state.search = 0;
+    state.target = UNKNOWN_PERSON;
+    state.targetFound = false;
+
+    string request;
+    while (receiveMessage(socket, request))
+    {
+        MessageWriter reply;
+        if (!state.handle(request, reply))
+            break;
+        sendMessage(socket, reply.payload());
+    }
+    close(socket);
+}
+
+// ==============================
+// ShardedSocialNetwork Implementation
+// ==============================
+
+ShardedSocialNetwork::ShardedSocialNetwork(int shardCount)
+{
+    shardCount = max(1, shardCount);
+    for (int i = 0; i < shardCount; i++)
+    {
+        int ends[2];
+        if (socketpair(AF_UNIX, SOCK_STREAM, 0, ends) != 0)
+        {
+            int error = errno;
+            stopShards();
+            throw runtime_error(string("cannot create shard socket: ") + strerror(error));
+        }
+#ifdef SO_NOSIGPIPE
+        int on = 1;
+        setsockopt(ends[0], SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+        setsockopt(ends[1], SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+#endif
+
+        pid_t pid = fork();
+        if (pid < 0)
+        {
+            int error = errno;
+            close(ends[0]);
+            close(ends[1]);
+            stopShards();
+            throw runtime_error(string("cannot start shard process: ") + strerror(error));
+        }
+
+        if (pid == 0)
+        {
+            // Worker: keep only its own end, so every shard sees EOF when the coordinator goes away
+            close(ends[0]);
+            for (size_t j = 0; j < shards.size(); j++)
+            {
+                close(shards[j].socket);
+            }
+            try
+            {
+                workerMain(ends[1], i, shardCount);
+            }
+            catch (...)
+            {
+                _exit(1);
+            }
+            _exit(0);
+        }
+
+        close(ends[1]);
+        Shard shard;
+        shard.pid = pid;
+        shard.socket = ends[0];
+        shards.push_back(shard);
+    }
+}
+
+ShardedSocialNetwork::~ShardedSocialNetwork()
+{
+    stopShards();
+}
+
+void ShardedSocialNetwork::stopShards()
+{
+    MessageWriter request;
+    request.putByte(SHUTDOWN);
+    for (size_t i = 0; i < shards.size(); i++)
+    {
+        try
+        {
+            sendMessage(shards[i].socket, request.payload());
+        }
+        catch (const runtime_error &)
+        {
+            // Already gone; closing the socket and reaping it is all that is left
+        }
+        close(shards[i].socket);
+    }
+    for (size_t i = 0; i < shards.size(); i++)
+    {
+        while (waitpid(shards[i].pid, NULL, 0) < 0 && errno == EINTR)
+        {
+        }
+    }
+    shards.clear();
+}
+
+vector<string> ShardedSocialNetwork::exchange(const vector<string> &requests)
+{
+    // All requests go out before any reply is read, so the shards work concurrently
+    for (size_t s = 0; s < shards.size(); s++)
+    {
+        if (!requests[s].empty())
+            sendMessage(shards[s].socket, requests[s]);
+    }
+
+    vector<string> replies(shards.size());
+    for (size_t s = 0; s < shards.size(); s++)
+    {
+        if (!requests[s].empty() && !receiveMessage(shards[s].socket, replies[s]))
+            throw runtime_error("shard " + to_string(s) + " exited unexpectedly");
+    }
+    return replies;
+}
+
+string ShardedSocialNetwork::call(int shard, const string &request)
+{
+    vector<string> requests(shards.size());
+    requests[shard] = request;
+    return exchange(requests)[shard];
+}
+
+vector<uint32_t> ShardedSocialNetwork::lookup(const vector<string> &people)
+{
+    vector<vector<string>> byShard(shards.size());
+    vector<size_t> slot(people.size());
+    for (size_t i = 0; i < people.size(); i++)
+    {
+        int owner = shardOf(people[i]);
+        slot[i] = byShard[owner].size();
+        byShard[owner].push_back(people[i]);
+    }
+
+    vector<string> requests(shards.size());
+    for (size_t s = 0; s < shards.size(); s++)
+    {
+        if (byShard[s].empty())
+            continue;
+        MessageWriter request;
+        request.putByte(LOOKUP);
+        request.putStrings(byShard[s]);
+        requests[s] = request.payload();
+    }
+    vector<string> replies = exchange(requests);
+
+    vector<vector<uint32_t>> found(shards.size());
+    for (size_t s = 0; s < shards.size(); s++)
+    {
+        if (!replies[s].empty())
+            found[s] = MessageReader(replies[s]).getIds();
+    }
+
+    vector<uint32_t> ids(people.size());
+    for (size_t i = 0; i < people.size(); i++)
+    {
+        ids[i] = found[shardOf(people[i])][slot[i]];
+    }
+    return ids;
+}
+
+vector<string> ShardedSocialNetwork::namesOf(const vector<uint32_t> &ids)
+{
+    vector<vector<uint32_t>> byShard(shards.size());
+    vector<size_t> slot(ids.size());
+    for (size_t i = 0; i < ids.size(); i++)
+    {
+        size_t owner = ids[i] % shards.size();
+        slot[i] = byShard[owner].size();
+        byShard[owner].push_back(ids[i]);
+    }
+
+    vector<string> requests(shards.size());
+    for (size_t s = 0; s < shards.size(); s++)
+    {
+        if (byShard[s].empty())
+            continue;
+        MessageWriter request;
+        request.putByte(NAMES_OF);
+        request.putIds(byShard[s]);
+        requests[s] = request.payload();
+    }
+    vector<string> replies = exchange(requests);
+
+    vector<vector<string>> found(shards.size());
+    for (size_t s = 0; s < shards.size(); s++)
+    {
+        if (!replies[s].empty())
+            found[s] = MessageReader(replies[s]).getStrings();
+    }
+
+    vector<string> names(ids.size());
+    for (size_t i = 0; i < ids.size(); i++)
+    {
+        names[i] = found[ids[i] % shards.size()][slot[i]];
+    }
+    return names;
+}
+
+void ShardedSocialNetwork::sendHalfEdges(const vector<vector<uint32_t>> &halfEdges, bool adding)
+{
+    vector<string> requests(shards.size());
+    for (size_t s = 0; s < shards.size(); s++)
+    {
+        if (halfEdges[s].empty())
+            continue;
+        MessageWriter request;
+        request.putByte(adding ? ADD_HALF_EDGES : REMOVE_HALF_EDGES);
+        request.putIds(halfEdges[s]);
+        requests[s] = request.payload();
+    }
+    exchange(requests);
+}
+
+int ShardedSocialNetwork::shardCount() const
+{
+    return (int)shards.size();
+}
+
+int ShardedSocialNetwork::shardOf(const string &person) const
+{
+    return ownerOf(person, (int)shards.size());
+}
+
+void ShardedSocialNetwork::addPerson(const string &person)
+{
+    addPeople(vector<string>(1, person));
+}
+
+void ShardedSocialNetwork::addPeople(const vector<string> &people)
+{
+    vector<vector<string>> byShard(shards.size());
+    for (size_t i = 0; i < people.size(); i++)
+    {
+        byShard[shardOf(people[i])].push_back(people[i]);
+    }
+
+    vector<string> requests(shards.size());
+    for (size_t s = 0; s < shards.size(); s++)
+    {
+        if (byShard[s].empty())
+            continue;
+        MessageWriter request;
+        request.putByte(ADD_PEOPLE);
+        request.putStrings(byShard[s]);
+        requests[s] = request.payload();
+    }
+    exchange(requests);
+}
+
+void ShardedSocialNetwork::addFriend(const string &personA, const string &personB)
+{
+    addFriends(vector<pair<string, string>>(1, make_pair(personA, personB)));
+}
+
+void ShardedSocialNetwork::addFriends(const vector<pair<string, string>> &friendships)
+{
+    // Round 1: resolve both ends of every friendship
+    vector<string> ends;
+    ends.reserve(friendships.size() * 2);
+    for (size_t i = 0; i < friendships.size(); i++)
+    {
+        ends.push_back(friendships[i].first);
+        ends.push_back(friendships[i].second);
+    }
+    vector<uint32_t> ids = lookup(ends);
+
+    // Round 2: send each valid friendship to the owners of both ends
+    vector<vector<uint32_t>> halfEdges(shards.size());
+    for (size_t i = 0; i < ids.size(); i += 2)
+    {
+        uint32_t a = ids[i], b = ids[i + 1];
+        if (a == UNKNOWN_PERSON || b == UNKNOWN_PERSON)
+            continue;
+        halfEdges[a % shards.size()].push_back(a);
+        halfEdges[a % shards.size()].push_back(b);
+        if (a != b)
+        {
+            halfEdges[b % shards.size()].push_back(b);
+            halfEdges[b % shards.size()].push_back(a);
+        }
+    }
+    sendHalfEdges(halfEdges, true);
+}
+
+void ShardedSocialNetwork::unfriend(const string &personA, const string &personB)
+{
+    vector<string> ends;
+    ends.push_back(personA);
+    ends.push_back(personB);
+    vector<uint32_t> ids = lookup(ends);
+    if (ids[0] == UNKNOWN_PERSON || ids[1] == UNKNOWN_PERSON)
+        return;
+
+    vector<vector<uint32_t>> halfEdges(shards.size());
+    halfEdges[ids[0] % shards.size()].push_back(ids[0]);
+    halfEdges[ids[0] % shards.size()].push_back(ids[1]);
+    halfEdges[ids[1] % shards.size()].push_back(ids[1]);
+    halfEdges[ids[1] % shards.size()].push_back(ids[0]);
+    sendHalfEdges(halfEdges, false);
+}
+
+bool ShardedSocialNetwork::deletePerson(const string &person)
+{
+    MessageWriter request;
+    request.putByte(DELETE_PERSON);
+    request.putString(person);
+    string reply = call(shardOf(person), request.payload());
+
+    MessageReader in(reply);
+    uint32_t id = in.getCount();
+    if (id == UNKNOWN_PERSON)
+        return false;
+
+    // Drop the person from each former friend's list, one batch per owner
+    vector<uint32_t> formerFriends = in.getIds();
+    vector<vector<uint32_t>> halfEdges(shards.size());
+    for (size_t i = 0; i < formerFriends.size(); i++)
+    {
+        halfEdges[formerFriends[i] % shards.size()].push_back(formerFriends[i]);
+        halfEdges[formerFriends[i] % shards.size()].push_back(id);
+    }
+    sendHalfEdges(halfEdges, false);
+    return true;
+}
+
+bool ShardedSocialNetwork::areFriends(const string &personA, const string &personB)
+{
+    vector<string> ends;
+    ends.push_back(personA);
+    ends.push_back(personB);
+    vector<uint32_t> ids = lookup(ends);
+    if (ids[0] == UNKNOWN_PERSON || ids[1] == UNKNOWN_PERSON)
+        return false;
+
+    MessageWriter request;
+    request.putByte(ARE_FRIENDS);
+    request.putCount(ids[0]);
+    request.putCount(ids[1]);
+    string reply = call(ids[0] % shards.size(), request.payload());
+    return MessageReader(reply).getByte() != 0;
+}
+
+vector<string> ShardedSocialNetwork::shortestPath(const string &begin, const string &finish)
+{
+    vector<string> ends;
+    ends.push_back(begin);
+    ends.push_back(finish);
+    vector<uint32_t> ids = lookup(ends);
+    if (ids[0] == UNKNOWN_PERSON || ids[1] == UNKNOWN_PERSON)
+        return vector<string>();
+    if (ids[0] == ids[1])
+        return vector<string>(1, begin);
+
+    size_t shardTotal = shards.size();
+    vector<string> requests(shardTotal);
+    MessageWriter start;
+    start.putByte(BFS_BEGIN);
+    start.putCount(ids[1]);
+    for (size_t s = 0; s < shardTotal; s++)
+    {
+        requests[s] = start.payload();
+    }
+    exchange(requests);
+
+    // discovered[s] holds the (ID, parent ID) pairs routed to shard s for the next
+    // level; the start is its own parent, which ends the walk back along the path
+    vector<vector<uint32_t>> discovered(shardTotal);
+    discovered[ids[0] % shardTotal].push_back(ids[0]);
+    discovered[ids[0] % shardTotal].push_back(ids[0]);
+    vector<uint32_t> frontierSize(shardTotal, 0);
+    bool found = false;
+
+    while (true)
+    {
+        for (size_t s = 0; s < shardTotal; s++)
+        {
+            MessageWriter request;
+            request.putByte(BFS_VISIT);
+            request.putIds(discovered[s]);
+            requests[s] = request.payload();
+            discovered[s].clear();
+        }
+        vector<string> replies = exchange(requests);
+
+        uint32_t levelSize = 0;
+        for (size_t s = 0; s < shardTotal; s++)
+        {
+            MessageReader in(replies[s]);
+            frontierSize[s] = in.getCount();
+            levelSize += frontierSize[s];
+            if (in.getByte())
+                found = true;
+        }
+        if (found || levelSize == 0)
+            break;
+
+        // Only shards with a non-empty frontier have anything to expand
+        MessageWriter expand;
+        expand.putByte(BFS_EXPAND);
+        for (size_t s = 0; s < shardTotal; s++)
+        {
+            requests[s] = frontierSize[s] > 0 ? expand.payload() : string();
+        }
+        replies = exchange(requests);
+
+        for (size_t s = 0; s < shardTotal; s++)
+        {
+            if (replies[s].empty())
+                continue;
+            MessageReader in(replies[s]);
+            for (size_t d = 0; d < shardTotal; d++)
+            {
+                vector<uint32_t> batch = in.getIds();
+                discovered[d].insert(discovered[d].end(), batch.begin(), batch.end());
+            }
+        }
+    }
+
+    if (!found)
+        return vector<string>();
+
+    vector<uint32_t> path(1, ids[1]);
+    while (path.back() != ids[0])
+    {
+        MessageWriter request;
+        request.putByte(BFS_PARENT);
+        request.putCount(path.back());
+        string reply = call(path.back() % shardTotal, request.payload());
+        uint32_t previous = MessageReader(reply).getCount();
+        if (previous == UNKNOWN_PERSON)
+            return vector<string>();
+        path.push_back(previous);
+    }
+    reverse(path.begin(), path.end());
+    return namesOf(path);
+}
+
+vector<string> ShardedSocialNetwork::topKPeople(const string &person, int k)
+{
+    if (k <= 0)
+        return vector<string>();
+    uint32_t id = lookup(vector<string>(1, person))[0];
+    if (id == UNKNOWN_PERSON)
+        return vector<string>();
+
+    MessageWriter lookupFriends;
+    lookupFriends.putByte(FRIENDS_OF);
+    lookupFriends.putCount(id);
+    string reply = call(id % shards.size(), lookupFriends.payload());
+    vector<uint32_t> friendList = MessageReader(reply).getIds();
+
+    // Scatter: each owner counts the friends-of-friends reachable through its share
+    vector<vector<uint32_t>> byShard(shards.size());
+    for (size_t i = 0; i < friendList.size(); i++)
+    {
+        byShard[friendList[i] % shards.size()].push_back(friendList[i]);
+    }
+
+    vector<string> requests(shards.size());
+    for (size_t s = 0; s < shards.size(); s++)
+    {
+        if (byShard[s].empty())
+            continue;
+        MessageWriter request;
+        request.putByte(TWO_HOP_COUNTS);
+        request.putCount(id);
+        request.putIds(byShard[s]);
+        requests[s] = request.payload();
+    }
+    vector<string> replies = exchange(requests);
+
+    // Gather: sum the partial counts and drop people who are already friends
+    unordered_map<uint32_t, int> mutualCount;
+    for (size_t s = 0; s < shards.size(); s++)
+    {
+        if (replies[s].empty())
+            continue;
+        vector<uint32_t> partial = MessageReader(replies[s]).getIds();
+        for (size_t i = 0; i + 1 < partial.size(); i += 2)
+        {
+            mutualCount[partial[i]] += (int)partial[i + 1];
+        }
+    }
+    for (size_t i = 0; i < friendList.size(); i++)
+    {
+        mutualCount.erase(friendList[i]);
+    }
+
+    vector<pair<int, uint32_t>> ranked;
+    ranked.reserve(mutualCount.size());
+    for (unordered_map<uint32_t, int>::iterator it = mutualCount.begin(); it != mutualCount.end(); ++it)
+    {
+        ranked.push_back(make_pair(-it->second, it->first));
+    }
+    size_t keep = min(ranked.size(), (size_t)k);
+    partial_sort(ranked.begin(), ranked.begin() + keep, ranked.end());
+
+    vector<uint32_t> best;
+    for (size_t i = 0; i < keep; i++)
+    {
+        best.push_back(ranked[i].second);
+    }
+    return namesOf(best);
+}
@@ -0,0 +1,182 @@
+#ifndef SHARDEDSOCIALNETWORK_H
+#define SHARDEDSOCIALNETWORK_H
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+#include <sys/types.h>
+
+using namespace std;
+
+/**
+ * @brief A social network partitioned across local worker processes.
+ *
+ * People are hash-partitioned by name across N shards. Each shard is a child
+ * process that owns its people's friend lists and talks to this coordinator over
+ * a Unix socket pair. Requests that touch several shards are sent to all of them
+ * before any reply is read, so the shards work in parallel.
+ *
+ * Inside the shards a person is known by a global ID, localId * N + shard, so the
+ * owner of any friend is its ID modulo N and messages carry IDs rather than names.
+ *
+ * - shortestPath runs a level-synchronous BFS: each level, every shard expands its
+ *   part of the frontier (visiting its own people directly) and the coordinator
+ *   routes the remote discoveries to their owners in one batch per shard.
+ * - topKPeople scatters the person's friends to their owners, which count the
+ *   friends-of-friends they can see, and gathers the partial counts.
+ *
+ * The shards are forked by the constructor, so create the network before starting
+ * any threads. POSIX only.
+ */
+class ShardedSocialNetwork
+{
+public:
+    /**
+     * @brief Starts the worker processes.
+     * @param shardCount Number of shards (at least 1).
+     * @throws runtime_error if a socket pair or process cannot be created.
+     */
+    explicit ShardedSocialNetwork(int shardCount);
+
+    /**
+     * @brief Stops the worker processes and waits for them to exit.
+     */
+    ~ShardedSocialNetwork();
+
+    ShardedSocialNetwork(const ShardedSocialNetwork &) = delete;
+    ShardedSocialNetwork &operator=(const ShardedSocialNetwork &) = delete;
+
+    /**
+     * @brief Number of shards.
+     */
+    int shardCount() const;
+
+    /**
+     * @brief Shard that owns a person.
+     * @param person Name of the person.
+     * @return Index of the owning shard.
+     */
+    int shardOf(const string &person) const;
+
+    /**
+     * @brief Adds a person to the network.
+     * @param person The name of the person to add.
+     */
+    void addPerson(const string &person);
+
+    /**
+     * @brief Adds many people at once, with one message per shard.
+     * @param people Names of the people to add.
+     */
+    void addPeople(const vector<string> &people);
+
+    /**
+     * @brief Creates a friendship between two existing people.
+     * @param personA Name of the first person.
+     * @param personB Name of the second person.
+     */
+    void addFriend(const string &personA, const string &personB);
+
+    /**
+     * @brief Creates many friendships at once, with two rounds of one message per shard.
+     * @param friendships Pairs of names; pairs naming an unknown person are skipped.
+     */
+    void addFriends(const vector<pair<string, string>> &friendships);
+
+    /**
+     * @brief Removes the friendship between two people.
+     * @param personA First person.
+     * @param personB Second person.
+     */
+    void unfriend(const string &personA, const string &personB);
+
+    /**
+     * @brief Deletes a person and all their friendships from the network.
+     * @param person The name of the person to remove.
+     * @return True if the person was found and deleted.
+     */
+    bool deletePerson(const string &person);
+
+    /**
+     * @brief Checks whether two people are friends.
+     * @param personA Name of the first person.
+     * @param personB Name of the second person.
+     * @return True if a friendship exists between them.
+     */
+    bool areFriends(const string &personA, const string &personB);
+
+    /**
+     * @brief Computes the shortest path between two people with a distributed BFS.
+     * @param begin Name of the starting person.
+     * @param finish Name of the destination person.
+     * @return The names along the path, or empty if unreachable.
+     * @note Costs two rounds of messages per BFS level, plus one per step of the path.
+     */
+    vector<string> shortestPath(const string &begin, const string &finish);
+
+    /**
+     * @brief Recommends top-K potential friends based on mutual connections.
+     * @param person Name of the person to recommend for.
+     * @param k Number of recommendations.
+     * @return Names of the recommended people, most mutual friends first.
+     */
+    vector<string> topKPeople(const string &person, int k);
+
+private:
+    /**
+     * @brief Coordinator's end of one shard's connection.
+     */
+    struct Shard
+    {
+        pid_t pid;  ///< Worker process
+        int socket; ///< Coordinator's end of the socket pair
+    };
+
+    vector<Shard> shards; ///< All shards, indexed by shard number
+
+    /**
+     * @brief Sends one request to each of the given shards, then collects their replies.
+     * @param requests requests[s] is the payload for shard s; empty payloads are not sent.
+     * @return replies[s] is shard s's reply (empty for shards that got no request).
+     */
+    vector<string> exchange(const vector<string> &requests);
+
+    /**
+     * @brief Sends one request to a single shard and waits for its reply.
+     */
+    string call(int shard, const string &request);
+
+    /**
+     * @brief Resolves names to global IDs, with one message per owning shard.
+     * @return One ID per name (UNKNOWN_PERSON for names not in the network).
+     */
+    vector<uint32_t> lookup(const vector<string> &people);
+
+    /**
+     * @brief Resolves global IDs back to names, with one message per owning shard.
+     */
+    vector<string> namesOf(const vector<uint32_t> &ids);
+
+    /**
+     * @brief Sends (owned ID, friend ID) pairs to their owners to add or remove.
+     * @param halfEdges halfEdges[s] holds the pairs for shard s.
+     * @param adding True to add the friendships, false to remove them.
+     */
+    void sendHalfEdges(const vector<vector<uint32_t>> &halfEdges, bool adding);
+
+    /**
+     * @brief Shuts down and reaps every started worker process.
+     */
+    void stopShards();
+
+    /**
+     * @brief Request loop run by each worker process.
+     * @param socket Worker's end of the socket pair.
+     * @param shardIndex Index of this shard.
+     * @param shardCount Total number of shards (for routing BFS discoveries).
+     */
+    static void workerMain(int socket, int shardIndex, int shardCount);
+};
+
+#endif // SHARDEDSOCIALNETWORK_H
@@ -1,6 +1,13 @@
 #include "SocialNetwork.h"
+#include "NameHash.h"
 #include <algorithm>
 #include <queue>
+#include <cstdint>
+#include <thread>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <mutex>
 
 // ==============================
 // Node Implementation
@@ -55,24 +62,122 @@ const SocialNetwork::Node &SocialNetwork::Edge::getNode2() const
 // SocialNetwork Implementation
 // ==============================
 
-SocialNetwork::SocialNetwork() {}
+const size_t SocialNetwork::DEFAULT_SKETCH_SIZE;
+const size_t SocialNetwork::DEFAULT_APPROXIMATE_DEGREE;
+
+SocialNetwork::SocialNetwork()
+{
+    this->sketchSize = DEFAULT_SKETCH_SIZE;
+    this->approximateDegreeThreshold = DEFAULT_APPROXIMATE_DEGREE;
+    this->influenceReady = false;
+    this->influenceStale = true;
+    this->influenceDamping = 0.85;
+    this->influenceTolerance = 1e-6;
+    this->influenceMaxIterations = 200;
+}
 
 SocialNetwork::SocialNetwork(vector<Edge> &edge_list, vector<Node> &nodes_list)
 {
     this->edgeList = edge_list;
     this->nodesList = nodes_list;
+    this->sketchSize = DEFAULT_SKETCH_SIZE;
+    this->approximateDegreeThreshold = DEFAULT_APPROXIMATE_DEGREE;
+    this->influenceReady = false;
+    this->influenceStale = true;
+    this->influenceDamping = 0.85;
+    this->influenceTolerance = 1e-6;
+    this->influenceMaxIterations = 200;
+    rebuildAdjacency();
 }
 
-int SocialNetwork::isnodefound(const Node &node) const
+void SocialNetwork::rebuildAdjacency()
 {
+    nodeIndex.clear();
     for (size_t i = 0; i < nodesList.size(); i++)
     {
-        if (nodesList[i] == node)
-        {
-            return i;
-        }
+        nodeIndex[nodesList[i].getName()] = i;
+    }
+
+    adjacencyList.assign(nodesList.size(), vector<int>());
+    for (size_t i = 0; i < edgeList.size(); i++)
+    {
+        int a = isnodefound(edgeList[i].getNode1());
+        int b = isnodefound(edgeList[i].getNode2());
+        if (a == -1 || b == -1)
+            continue;
+        adjacencyList[a].push_back(b);
+        if (a != b)
+            adjacencyList[b].push_back(a);
+    }
+
+    personHash.resize(nodesList.size());
+    friendSketches.assign(nodesList.size(), vector<uint64_t>());
+    for (size_t i = 0; i < nodesList.size(); i++)
+    {
+        personHash[i] = hashName(nodesList[i].getName());
+    }
+    for (size_t i = 0; i < nodesList.size(); i++)
+    {
+        rebuildSketch(i);
+    }
+
+    friendCount.resize(nodesList.size());
+    inverseDegree.resize(nodesList.size());
+    inverseLogDegree.resize(nodesList.size());
+    for (size_t i = 0; i < nodesList.size(); i++)
+    {
+        refreshDegreeScores(i);
+    }
+
+    influenceScores.clear();
+    influenceReady = false;
+    influenceStale = true;
+}
+
+void SocialNetwork::refreshDegreeScores(int idx)
+{
+    friendCount[idx] = adjacencyList[idx].size();
+    double degree = friendCount[idx];
+    inverseDegree[idx] = degree > 0 ? 1.0 / degree : 0.0;
+    inverseLogDegree[idx] = degree > 1 ? 1.0 / log(degree) : 0.0;
+}
+
+void SocialNetwork::removeAdjacency(int idxA, int idxB)
+{
+    vector<int> &friendsA = adjacencyList[idxA];
+    vector<int>::iterator it = find(friendsA.begin(), friendsA.end(), idxB);
+    if (it != friendsA.end())
+        friendsA.erase(it);
+
+    if (idxA == idxB)
+        return;
+
+    vector<int> &friendsB = adjacencyList[idxB];
+    it = find(friendsB.begin(), friendsB.end(), idxA);
+    if (it != friendsB.end())
+        friendsB.erase(it);
+}
+
+int SocialNetwork::isnodefound(const Node &node) const
+{
+    unordered_map<string, int>::const_iterator it = nodeIndex.find(node.getName());
+    if (it == nodeIndex.end())
+    {
+        return -1;
     }
-    return -1;
+    return it->second;
+}
+
+int SocialNetwork::personId(const string &person) const
+{
+    return isnodefound(Node(person));
+}
+
+string SocialNetwork::personName(int id) const
+{
+    if (id < 0 || id >= (int)nodesList.size())
+        return "";
+    return nodesList[id].getName();
 }
 
 void SocialNetwork::addPerson(const string &person)
@@ -80,7 +185,17 @@ void SocialNetwork::addPerson(const string &person)
     Node node(person);
     if (isnodefound(node) == -1)
     {
+        nodeIndex[person] = nodesList.size();
         nodesList.push_back(node);
+        adjacencyList.push_back(vector<int>());
+        personHash.push_back(hashName(person));
+        friendSketches.push_back(vector<uint64_t>());
+        friendCount.push_back(0);
+        inverseDegree.push_back(0.0);
+        inverseLogDegree.push_back(0.0);
+        if (influenceReady)
+            influenceScores.push_back(1.0 / nodesList.size());
+        influenceStale = true;
     }
 }
 
@@ -88,11 +203,23 @@ void SocialNetwork::addFriend(const string &personA, const string &personB)
 {
     Node node1(personA);
     Node node2(personB);
-    if (isnodefound(node1) == -1 || isnodefound(node2) == -1)
+    int idx1 = isnodefound(node1);
+    int idx2 = isnodefound(node2);
+    if (idx1 == -1 || idx2 == -1)
         return;
     if (areFriends(node1.getName(), node2.getName()))
         return;
     edgeList.push_back(Edge(node1, node2));
+    adjacencyList[idx1].push_back(idx2);
+    insertIntoSketch(idx1, personHash[idx2]);
+    refreshDegreeScores(idx1);
+    if (idx1 != idx2)
+    {
+        adjacencyList[idx2].push_back(idx1);
+        insertIntoSketch(idx2, personHash[idx1]);
+        refreshDegreeScores(idx2);
+    }
+    influenceStale = true;
 }
 
 void SocialNetwork::unfriend(const string &personA, const string &personB)
@@ -105,6 +232,17 @@ void SocialNetwork::unfriend(const string &personA, const string &personB)
             (edgeList[i].getNode1() == node2 && edgeList[i].getNode2() == node1))
         {
             edgeList.erase(edgeList.begin() + i);
+            int idx1 = isnodefound(node1);
+            int idx2 = isnodefound(node2);
+            removeAdjacency(idx1, idx2);
+            removeFromSketch(idx1, personHash[idx2]);
+            refreshDegreeScores(idx1);
+            if (idx1 != idx2)
+            {
+                removeFromSketch(idx2, personHash[idx1]);
+                refreshDegreeScores(idx2);
+            }
+            influenceStale = true;
             return; // FIX: Exit after finding and removing the edge
         }
     }
@@ -123,9 +261,48 @@ bool SocialNetwork::deletePerson(const string &person)
         }
     }
 
-    if (isnodefound(node) != -1)
+    int idx = isnodefound(node);
+    if (idx != -1)
     {
-        nodesList.erase(nodesList.begin() + isnodefound(node));
+        nodesList.erase(nodesList.begin() + idx);
+        nodeIndex.erase(person);
+        for (size_t i = idx; i < nodesList.size(); i++)
+        {
+            nodeIndex[nodesList[i].getName()] = i;
+        }
+
+        vector<int> formerFriends = adjacencyList[idx];
+        uint64_t formerHash = personHash[idx];
+
+        // Drop the person's row and shift every ID above theirs down by one
+        adjacencyList.erase(adjacencyList.begin() + idx);
+        personHash.erase(personHash.begin() + idx);
+        friendSketches.erase(friendSketches.begin() + idx);
+        friendCount.erase(friendCount.begin() + idx);
+        inverseDegree.erase(inverseDegree.begin() + idx);
+        inverseLogDegree.erase(inverseLogDegree.begin() + idx);
+        if (influenceReady)
+            influenceScores.erase(influenceScores.begin() + idx);
+        influenceStale = true;
+        for (size_t i = 0; i < adjacencyList.size(); i++)
+        {
+            vector<int> &friends = adjacencyList[i];
+            friends.erase(remove(friends.begin(), friends.end(), idx), friends.end());
+            for (size_t j = 0; j < friends.size(); j++)
+            {
+                if (friends[j] > idx)
+                    friends[j]--;
+            }
+        }
+
+        for (size_t i = 0; i < formerFriends.size(); i++)
+        {
+            if (formerFriends[i] == idx)
+                continue;
+            int friendIdx = formerFriends[i] > idx ? formerFriends[i] - 1 : formerFriends[i];
+            removeFromSketch(friendIdx, formerHash);
+            refreshDegreeScores(friendIdx);
+        }
         return true;
     }
     return false;
@@ -133,37 +310,44 @@ bool SocialNetwork::deletePerson(const string &person)
 
 bool SocialNetwork::areFriends(const string &personA, const string &personB) const
 {
-    Node node1(personA);
-    Node node2(personB);
-    for (size_t i = 0; i < edgeList.size(); i++)
-    {
-        if ((edgeList[i].getNode1() == node1 && edgeList[i].getNode2() == node2) ||
-            (edgeList[i].getNode1() == node2 && edgeList[i].getNode2() == node1))
-        {
-            return true;
-        }
-    }
-    return false;
+    int idx1 = isnodefound(Node(personA));
+    int idx2 = isnodefound(Node(personB));
+    if (idx1 == -1 || idx2 == -1)
+        return false;
+
+    // Scan the shorter of the two friend lists
+    if (adjacencyList[idx1].size() > adjacencyList[idx2].size())
+        swap(idx1, idx2);
+    const vector<int> &friends = adjacencyList[idx1];
+    return find(friends.begin(), friends.end(), idx2) != friends.end();
 }
 
 vector<SocialNetwork::Node> SocialNetwork::getNeighbors(const Node &node1) const
 {
     vector<SocialNetwork::Node> allfriends;
-    for (size_t i = 0; i < edgeList.size(); i++)
+    int idx = isnodefound(node1);
+    if (idx == -1)
+        return allfriends;
+
+    const vector<int> &friends = adjacencyList[idx];
+    allfriends.reserve(friends.size());
+    for (size_t i = 0; i < friends.size(); i++)
     {
-        if (edgeList[i].getNode1() == node1 || edgeList[i].getNode2() == node1)
-        {
-            if (edgeList[i].getNode1() == node1)
-                allfriends.push_back(edgeList[i].getNode2());
-            else
-                allfriends.push_back(edgeList[i].getNode1());
-        }
+        allfriends.push_back(nodesList[friends[i]]);
     }
     return allfriends;
 }
 
 vector<SocialNetwork::Node> SocialNetwork::shortestPath(const string &begin, const string &finish) const
 {
+    return shortestPath(begin, finish, chrono::steady_clock::time_point::max());
+}
+
+vector<SocialNetwork::Node> SocialNetwork::shortestPath(const string &begin, const string &finish, const chrono::steady_clock::time_point &deadline, bool *timedOut) const
+{
+    if (timedOut != nullptr)
+        *timedOut = false;
+
     Node start(begin);
     Node end(finish);
     if (isnodefound(start) == -1 || isnodefound(end) == -1)
@@ -184,6 +368,7 @@ vector<SocialNetwork::Node> SocialNetwork::shortestPath(const string &begin, con
     visited[startIdx] = true;
     q.push(startIdx);
 
+    size_t dequeued = 0;
     while (!q.empty())
     {
         int current = q.front();
@@ -194,11 +379,17 @@ vector<SocialNetwork::Node> SocialNetwork::shortestPath(const string &begin, con
             break;
         }
 
-        vector<Node> neighbors = getNeighbors(nodesList[current]);
+        if ((++dequeued & 1023) == 0 && chrono::steady_clock::now() >= deadline)
+        {
+            if (timedOut != nullptr)
+                *timedOut = true;
+            return vector<Node>();
+        }
+
+        const vector<int> &neighbors = adjacencyList[current];
         for (size_t i = 0; i < neighbors.size(); ++i)
         {
-            const Node &neighbor = neighbors[i];
-            int neighborIdx = isnodefound(neighbor);
+            int neighborIdx = neighbors[i];
             if (!visited[neighborIdx])
             {
                 visited[neighborIdx] = true;
@@ -280,11 +471,10 @@ vector<SocialNetwork::Node> SocialNetwork::shortestPathAvoidingNodes(const strin
             break;
         }
 
-        vector<Node> neighbors = getNeighbors(nodesList[current]);
+        const vector<int> &neighbors = adjacencyList[current];
         for (size_t i = 0; i < neighbors.size(); ++i)
         {
-            const Node &neighbor = neighbors[i];
-            int neighborIdx = isnodefound(neighbor);
+            int neighborIdx = neighbors[i];
             if (!visited[neighborIdx])
             {
                 visited[neighborIdx] = true;
@@ -308,6 +498,181 @@ vector<SocialNetwork::Node> SocialNetwork::shortestPathAvoidingNodes(const strin
     return path;
 }
 
+// ==============================
+// Multi-Source BFS Implementation
+// ==============================
+
+const size_t SocialNetwork::MS_BFS_BATCH;
+
+void SocialNetwork::multiSourceBFS(const vector<int> &sources, vector<vector<int>> *distances, vector<vector<int>> *parents) const
+{
+    size_t n = nodesList.size();
+    if (distances != nullptr)
+    {
+        distances->assign(sources.size(), vector<int>(n, -1));
+    }
+    if (parents != nullptr)
+    {
+        parents->assign(sources.size(), vector<int>(n, -1));
+    }
+
+    // Bit i of each word belongs to sources[i]: seen = reached at any level,
+    // visit = current frontier, visitNext = frontier being built
+    vector<uint64_t> seen(n, 0);
+    vector<uint64_t> visit(n, 0);
+    vector<uint64_t> visitNext(n, 0);
+    for (size_t i = 0; i < sources.size(); i++)
+    {
+        uint64_t bit = uint64_t(1) << i;
+        seen[sources[i]] |= bit;
+        visit[sources[i]] |= bit;
+        if (distances != nullptr)
+            (*distances)[i][sources[i]] = 0;
+    }
+
+    bool active = !sources.empty();
+    for (int level = 1; active; level++)
+    {
+        // One scan of each frontier person's friends serves every source in the batch
+        for (size_t v = 0; v < n; v++)
+        {
+            uint64_t bits = visit[v];
+            if (bits == 0)
+                continue;
+
+            const vector<int> &neighbors = adjacencyList[v];
+            for (size_t j = 0; j < neighbors.size(); j++)
+            {
+                int neighborIdx = neighbors[j];
+                if (parents != nullptr)
+                {
+                    uint64_t fresh = bits & ~seen[neighborIdx] & ~visitNext[neighborIdx];
+                    while (fresh != 0)
+                    {
+                        (*parents)[__builtin_ctzll(fresh)][neighborIdx] = v;
+                        fresh &= fresh - 1;
+                    }
+                }
+                visitNext[neighborIdx] |= bits;
+            }
+        }
+
+        active = false;
+        for (size_t v = 0; v < n; v++)
+        {
+            uint64_t fresh = visitNext[v] & ~seen[v];
+            visitNext[v] = 0;
+            visit[v] = fresh;
+            if (fresh == 0)
+                continue;
+
+            active = true;
+            seen[v] |= fresh;
+            if (distances == nullptr)
+                continue;
+            while (fresh != 0)
+            {
+                (*distances)[__builtin_ctzll(fresh)][v] = level;
+                fresh &= fresh - 1;
+            }
+        }
+    }
+}
+
+vector<vector<int>> SocialNetwork::multiSourceDistances(const vector<string> &sources) const
+{
+    vector<vector<int>> result(sources.size());
+
+    vector<int> batch;
+    vector<size_t> batchSlots;
+    vector<vector<int>> distances;
+    for (size_t i = 0; i <= sources.size(); i++)
+    {
+        if (batch.size() == MS_BFS_BATCH || (i == sources.size() && !batch.empty()))
+        {
+            multiSourceBFS(batch, &distances, nullptr);
+            for (size_t j = 0; j < batch.size(); j++)
+            {
+                result[batchSlots[j]].swap(distances[j]);
+            }
+            batch.clear();
+            batchSlots.clear();
+        }
+        if (i == sources.size())
+            break;
+
+        int sourceIdx = isnodefound(Node(sources[i]));
+        if (sourceIdx == -1)
+        {
+            result[i].assign(nodesList.size(), -1);
+            continue;
+        }
+        batch.push_back(sourceIdx);
+        batchSlots.push_back(i);
+    }
+    return result;
+}
+
+vector<vector<SocialNetwork::Node>> SocialNetwork::shortestPaths(const vector<pair<string, string>> &queries) const
+{
+    vector<vector<Node>> paths(queries.size());
+
+    // Resolve the queries and give every distinct source a slot in some batch
+    vector<int> queryStart(queries.size(), -1);
+    vector<int> queryEnd(queries.size(), -1);
+    vector<int> sourceSlot(nodesList.size(), -1);
+    vector<int> sourcesInOrder;
+    for (size_t q = 0; q < queries.size(); q++)
+    {
+        int startIdx = isnodefound(Node(queries[q].first));
+        int endIdx = isnodefound(Node(queries[q].second));
+        if (startIdx == -1 || endIdx == -1)
+            continue;
+
+        if (startIdx == endIdx)
+        {
+            paths[q].push_back(nodesList[startIdx]);
+            continue;
+        }
+
+        queryStart[q] = startIdx;
+        queryEnd[q] = endIdx;
+        if (sourceSlot[startIdx] == -1)
+        {
+            sourceSlot[startIdx] = sourcesInOrder.size();
+            sourcesInOrder.push_back(startIdx);
+        }
+    }
+
+    vector<vector<int>> parents;
+    for (size_t first = 0; first < sourcesInOrder.size(); first += MS_BFS_BATCH)
+    {
+        size_t last = min(first + MS_BFS_BATCH, sourcesInOrder.size());
+        vector<int> batch(sourcesInOrder.begin() + first, sourcesInOrder.begin() + last);
+        multiSourceBFS(batch, nullptr, &parents);
+
+        for (size_t q = 0; q < queries.size(); q++)
+        {
+            if (queryStart[q] == -1)
+                continue;
+            size_t slot = sourceSlot[queryStart[q]];
+            if (slot < first || slot >= last)
+                continue;
+
+            const vector<int> &parent = parents[slot - first];
+            if (parent[queryEnd[q]] == -1)
+                continue;
+
+            for (int at = queryEnd[q]; at != -1; at = parent[at])
+            {
+                paths[q].push_back(nodesList[at]);
+            }
+            reverse(paths[q].begin(), paths[q].end());
+        }
+    }
+    return paths;
+}
+
 int SocialNetwork::nbOfCommonFriends(const Node &node1, const Node &node2) const
 {
     if (isnodefound(node1) == -1 || isnodefound(node2) == -1)
@@ -336,57 +701,208 @@ int SocialNetwork::nbOfCommonFriends(const Node &node1, const Node &node2) const
     return count;
 }
 
-vector<SocialNetwork::Node> SocialNetwork::topKPeople(const string &person, int k)
+// ==============================
+// Recommendation Scoring Policies
+// ==============================
+
+/**
+ * @brief Number of mutual friends.
+ */
+struct SocialNetwork::MutualFriendsScore
 {
-    Node targetNode(person);
-    vector<Node> recommendations;
+    typedef int Score;
+    typedef int Rank;
+    static const bool usesCandidateDegree = false;
+    static Score weight(const SocialNetwork &, int) { return 1; }
+    static Rank finalize(Score sum, size_t, size_t) { return sum; }
+};
+
+/**
+ * @brief Adamic-Adar: mutual friends with fewer friends of their own count more.
+ */
+struct SocialNetwork::AdamicAdarScore
+{
+    typedef double Score;
+    typedef double Rank;
+    static const bool usesCandidateDegree = false;
+    static Score weight(const SocialNetwork &network, int friendIdx) { return network.inverseLogDegree[friendIdx]; }
+    static Rank finalize(Score sum, size_t, size_t) { return sum; }
+};
+
+/**
+ * @brief Resource allocation: like Adamic-Adar, with a steeper 1 / degree penalty.
+ */
+struct SocialNetwork::ResourceAllocationScore
+{
+    typedef double Score;
+    typedef double Rank;
+    static const bool usesCandidateDegree = false;
+    static Score weight(const SocialNetwork &network, int friendIdx) { return network.inverseDegree[friendIdx]; }
+    static Rank finalize(Score sum, size_t, size_t) { return sum; }
+};
+
+/**
+ * @brief Jaccard: mutual friends relative to the size of both friend lists combined.
+ */
+struct SocialNetwork::JaccardScore
+{
+    typedef int Score;
+    typedef double Rank;
+    static const bool usesCandidateDegree = true;
+    static Score weight(const SocialNetwork &, int) { return 1; }
+    static Rank finalize(Score sum, size_t targetDegree, size_t candidateDegree)
+    {
+        return (double)sum / (targetDegree + candidateDegree - sum);
+    }
+};
+
+/**
+ * @brief Clears the entries a rankRecommendations query marked in its per-thread
+ * scratch arrays when the query ends, including by an exception, so the next query
+ * on that thread starts from clean arrays.
+ */
+template <class Score>
+class RecommendationScratchGuard
+{
+    vector<Score> &scores;
+    vector<char> &excluded;
+    vector<int> &candidates;
+    const vector<int> &friends;
+    int targetIdx;
+
+public:
+    RecommendationScratchGuard(vector<Score> &scores, vector<char> &excluded, vector<int> &candidates,
+                               const vector<int> &friends, int targetIdx)
+        : scores(scores), excluded(excluded), candidates(candidates), friends(friends), targetIdx(targetIdx)
+    {
+    }
 
-    if (isnodefound(targetNode) == -1 || k <= 0)
+    ~RecommendationScratchGuard()
     {
-        return recommendations;
+        for (size_t i = 0; i < candidates.size(); i++)
+        {
+            scores[candidates[i]] = 0;
+            excluded[candidates[i]] = 0;
+        }
+        candidates.clear();
+        excluded[targetIdx] = 0;
+        for (size_t i = 0; i < friends.size(); i++)
+        {
+            excluded[friends[i]] = 0;
+        }
     }
+};
 
-    vector<pair<Node, int>> potentialFriends;
+template <class Scorer>
+vector<SocialNetwork::Node> SocialNetwork::rankRecommendations(int targetIdx, int k) const
+{
+    // Per-thread scratch arrays, sized once and cleaned up entry by entry, so a query
+    // only pays for the part of the graph it touches. excluded is 1 for the person and
+    // their friends, 2 for candidates already seen
+    static thread_local vector<typename Scorer::Score> scores;
+    static thread_local vector<char> excluded;
+    static thread_local vector<int> candidates;
+    // excluded grows first: if growing scores throws, the size check retries both
+    if (scores.size() < nodesList.size())
+    {
+        excluded.resize(nodesList.size(), 0);
+        scores.resize(nodesList.size(), 0);
+    }
 
-    for (size_t i = 0; i < nodesList.size(); i++)
+    const vector<int> &friends = adjacencyList[targetIdx];
+    RecommendationScratchGuard<typename Scorer::Score> guard(scores, excluded, candidates, friends, targetIdx);
+    excluded[targetIdx] = 1;
+    for (size_t i = 0; i < friends.size(); i++)
     {
-        const Node &currentNode = nodesList[i];
+        excluded[friends[i]] = 1;
+    }
 
-        if (currentNode == targetNode)
-        {
+    // Every path target -> friend -> candidate adds that friend's weight to the candidate
+    for (size_t i = 0; i < friends.size(); i++)
+    {
+        if (friends[i] == targetIdx)
             continue;
-        }
 
-        if (areFriends(targetNode.getName(), currentNode.getName()))
+        typename Scorer::Score weight = Scorer::weight(*this, friends[i]);
+        const vector<int> &friendsOfFriend = adjacencyList[friends[i]];
+        for (size_t j = 0; j < friendsOfFriend.size(); j++)
         {
-            continue;
+            int candidate = friendsOfFriend[j];
+            if (excluded[candidate] == 1)
+                continue;
+            if (excluded[candidate] == 0)
+            {
+                // Recorded before being marked, so the guard can always clear the mark
+                candidates.push_back(candidate);
+                excluded[candidate] = 2;
+            }
+            scores[candidate] += weight;
         }
+    }
 
-        int commonFriends = nbOfCommonFriends(targetNode, currentNode);
-
-        if (commonFriends > 0)
+    // Keep the k best candidates in a heap whose top is the worst of them, so each
+    // candidate's final score is computed exactly once
+    typedef pair<typename Scorer::Rank, int> Entry;
+    size_t targetDegree = friends.size();
+    auto better = [](const Entry &a, const Entry &b)
+    {
+        if (a.first != b.first)
+            return a.first > b.first;
+        return a.second < b.second;
+    };
+    priority_queue<Entry, vector<Entry>, decltype(better)> best(better);
+    for (size_t i = 0; i < candidates.size(); i++)
+    {
+        int candidate = candidates[i];
+        size_t candidateDegree = Scorer::usesCandidateDegree ? friendCount[candidate] : 0;
+        Entry entry(Scorer::finalize(scores[candidate], targetDegree, candidateDegree), candidate);
+        if (best.size() < (size_t)k)
+            best.push(entry);
+        else if (better(entry, best.top()))
         {
-            potentialFriends.push_back(make_pair(currentNode, commonFriends));
+            best.pop();
+            best.push(entry);
         }
     }
 
-    sort(potentialFriends.begin(), potentialFriends.end(),
-         [](const pair<Node, int> &a, const pair<Node, int> &b)
-         {
-             return a.second > b.second;
-         });
+    vector<Node> recommendations(best.size());
+    for (size_t i = best.size(); i > 0; i--)
+    {
+        recommendations[i - 1] = nodesList[best.top().second];
+        best.pop();
+    }
+    return recommendations;
+}
 
-    for (int i = 0; i < min(k, (int)potentialFriends.size()); i++)
+vector<SocialNetwork::Node> SocialNetwork::topKPeople(const string &person, int k, RecommendationPolicy policy) const
+{
+    int targetIdx = isnodefound(Node(person));
+    if (targetIdx == -1 || k <= 0)
     {
-        recommendations.push_back(potentialFriends[i].first);
+        return vector<Node>();
     }
 
-    return recommendations;
+    switch (policy)
+    {
+    case ADAMIC_ADAR:
+        return rankRecommendations<AdamicAdarScore>(targetIdx, k);
+    case RESOURCE_ALLOCATION:
+        return rankRecommendations<ResourceAllocationScore>(targetIdx, k);
+    case JACCARD:
+        return rankRecommendations<JaccardScore>(targetIdx, k);
+    case MUTUAL_FRIENDS:
+    default:
+        if (adjacencyList[targetIdx].size() >= approximateDegreeThreshold)
+        {
+            return approximateTopKPeople(person, k);
+        }
+        return rankRecommendations<MutualFriendsScore>(targetIdx, k);
+    }
 }
 
-void SocialNetwork::displayTopKPeople(const string &person, int k)
+void SocialNetwork::displayTopKPeople(const string &person, int k, RecommendationPolicy policy)
 {
-    vector<Node> n = topKPeople(person, k);
+    vector<Node> n = topKPeople(person, k, policy);
     for (size_t i = 0; i < n.size(); i++)
     {
         cout << n[i].getName() << " ";
@@ -413,19 +929,960 @@ void SocialNetwork::displayShortestPathAvoidingNodes(const string &begin, const
 
 void SocialNetwork::displaySocialNetWork()
 {
+    exportNetwork(cout, TEXT_FORMAT);
+    cout.flush();
+}
+
+// ==============================
+// K-Hop Neighborhood Implementation
+// ==============================
+
+SocialNetwork::KHopCursor::KHopCursor(const SocialNetwork *network, int maxHops, size_t limit)
+{
+    this->network = network;
+    this->frontierPos = 0;
+    this->neighborPos = 0;
+    this->hop = 0;
+    this->maxHops = maxHops;
+    this->limit = limit;
+    this->emitted = 0;
+}
+
+bool SocialNetwork::KHopCursor::next(int &id, int &distance)
+{
+    if (limit != 0 && emitted >= limit)
+        return false;
+
+    while (hop < maxHops && !frontier.empty())
+    {
+        while (frontierPos < frontier.size())
+        {
+            const vector<int> &friends = network->adjacencyList[frontier[frontierPos]];
+            while (neighborPos < friends.size())
+            {
+                int neighborIdx = friends[neighborPos++];
+                if (!visited[neighborIdx])
+                {
+                    visited[neighborIdx] = true;
+                    nextFrontier.push_back(neighborIdx);
+                    id = neighborIdx;
+                    distance = hop + 1;
+                    emitted++;
+                    return true;
+                }
+            }
+            neighborPos = 0;
+            frontierPos++;
+        }
+
+        // Current level exhausted, move on to the people discovered from it
+        frontier.swap(nextFrontier);
+        nextFrontier.clear();
+        frontierPos = 0;
+        hop++;
+    }
+    return false;
+}
+
+SocialNetwork::KHopCursor SocialNetwork::kHopCursor(const string &person, int k, const vector<string> &blacklister, size_t limit) const
+{
+    KHopCursor cursor(this, k, limit);
+    int startIdx = personId(person);
+    if (startIdx == -1 || k <= 0)
+    {
+        return cursor;
+    }
+
+    cursor.visited.assign(nodesList.size(), false);
+    for (size_t i = 0; i < blacklister.size(); ++i)
+    {
+        int nodeIdx = personId(blacklister[i]);
+        if (nodeIdx == startIdx)
+        {
+            return KHopCursor(this, k, limit);
+        }
+        if (nodeIdx != -1)
+        {
+            cursor.visited[nodeIdx] = true;
+        }
+    }
+
+    cursor.visited[startIdx] = true;
+    cursor.frontier.push_back(startIdx);
+    return cursor;
+}
+
+vector<int> SocialNetwork::kHopNeighborhood(const string &person, int k, const vector<string> &blacklister, size_t limit, vector<int> *hopCounts) const
+{
+    if (hopCounts != nullptr)
+    {
+        hopCounts->clear();
+    }
+
+    vector<int> reached;
+    KHopCursor cursor = kHopCursor(person, k, blacklister, limit);
+    int id, distance;
+    while (cursor.next(id, distance))
+    {
+        reached.push_back(id);
+        if (hopCounts != nullptr)
+        {
+            // Distances come out in increasing order, so this grows one level at a time
+            if ((int)hopCounts->size() < distance)
+                hopCounts->resize(distance, 0);
+            (*hopCounts)[distance - 1]++;
+        }
+    }
+
+    sort(reached.begin(), reached.end());
+    return reached;
+}
+
+vector<bool> SocialNetwork::kHopBitmap(const string &person, int k, const vector<string> &blacklister) const
+{
+    vector<bool> bitmap(nodesList.size(), false);
+    KHopCursor cursor = kHopCursor(person, k, blacklister);
+    int id, distance;
+    while (cursor.next(id, distance))
+    {
+        bitmap[id] = true;
+    }
+    return bitmap;
+}
+
+void SocialNetwork::displayKHopNeighborhood(const string &person, int k)
+{
+    vector<int> hopCounts;
+    vector<int> reached = kHopNeighborhood(person, k, vector<string>(), 0, &hopCounts);
+    for (size_t i = 0; i < reached.size(); i++)
+    {
+        cout << nodesList[reached[i]].getName() << " ";
+    }
+    cout << "\n";
+    for (size_t d = 0; d < hopCounts.size(); d++)
+    {
+        cout << "Hop " << (d + 1) << ": " << hopCounts[d] << " people\n";
+    }
+}
+
+// ==============================
+// Triangle Analytics Implementation
+// ==============================
+
+SocialNetwork::TriangleStatistics SocialNetwork::triangleStatistics(unsigned threads) const
+{
+    int n = nodesList.size();
+    TriangleStatistics stats;
+    stats.totalTriangles = 0;
+    stats.triangles.assign(n, 0);
+    stats.clustering.assign(n, 0.0);
+    stats.averageClustering = 0.0;
+    stats.globalClustering = 0.0;
+
+    // Degrees without self-friendships, which can't be part of a triangle
+    vector<long long> degree(n, 0);
+    for (int v = 0; v < n; v++)
+    {
+        const vector<int> &friends = adjacencyList[v];
+        degree[v] = friends.size() - count(friends.begin(), friends.end(), v);
+    }
+
+    // People in ascending (degree, ID) order, by counting sort on the degree;
+    // rank[v] is v's position in it
+    long long maxDegree = 0;
+    for (int v = 0; v < n; v++)
+        maxDegree = max(maxDegree, degree[v]);
+    vector<int> bucketStart(maxDegree + 2, 0);
+    for (int v = 0; v < n; v++)
+        bucketStart[degree[v] + 1]++;
+    for (long long d = 0; d <= maxDegree; d++)
+        bucketStart[d + 1] += bucketStart[d];
+    vector<int> order(n);
+    for (int v = 0; v < n; v++)
+        order[bucketStart[degree[v]]++] = v;
+    vector<int> rank(n);
+    for (int r = 0; r < n; r++)
+        rank[order[r]] = r;
+
+    // Oriented adjacency in CSR form over ranks: r -> s only if r < s
+    vector<size_t> offsets(n + 1, 0);
+    vector<int> targets;
+    for (int r = 0; r < n; r++)
+    {
+        const vector<int> &friends = adjacencyList[order[r]];
+        for (size_t i = 0; i < friends.size(); i++)
+        {
+            if (rank[friends[i]] > r)
+                targets.push_back(rank[friends[i]]);
+        }
+        sort(targets.begin() + offsets[r], targets.end());
+        offsets[r + 1] = targets.size();
+    }
+
+    if (threads == 0)
+        threads = max(1u, thread::hardware_concurrency());
+    threads = min<unsigned>(threads, max(n, 1));
+
+    // One shared counter per person, so memory does not grow with the thread count.
+    // Only the worker handling r touches it as the triangle's first corner. The other
+    // two corners always rank higher, so on a power-law network they are mostly the
+    // few hubs; the top HUB_COUNT ranks are counted in a small private array per
+    // worker and merged at the end, and only the rest are updated atomically
+    const int chunk = 64;
+    const int HUB_COUNT = 4096;
+    const int hubStart = max(0, n - HUB_COUNT);
+    atomic<int> nextPerson(0);
+    vector<atomic<long long>> counts(n);
+    for (int r = 0; r < n; r++)
+        counts[r].store(0, memory_order_relaxed);
+    vector<vector<long long>> hubCounts(threads);
+    vector<long long> localTotals(threads, 0);
+
+    auto worker = [&](unsigned t)
+    {
+        vector<long long> &hubs = hubCounts[t];
+        hubs.assign(n - hubStart, 0);
+        long long total = 0;
+        for (int first = nextPerson.fetch_add(chunk); first < n; first = nextPerson.fetch_add(chunk))
+        {
+            int last = min(first + chunk, n);
+            for (int r = first; r < last; r++)
+            {
+                long long found = 0;
+                for (size_t i = offsets[r]; i < offsets[r + 1]; i++)
+                {
+                    int s = targets[i];
+
+                    // Sorted-list intersection of r's and s's oriented friends
+                    size_t a = offsets[r], b = offsets[s];
+                    while (a < offsets[r + 1] && b < offsets[s + 1])
+                    {
+                        if (targets[a] < targets[b])
+                            a++;
+                        else if (targets[a] > targets[b])
+                            b++;
+                        else
+                        {
+                            found++;
+                            if (s >= hubStart)
+                                hubs[s - hubStart]++;
+                            else
+                                counts[s].fetch_add(1, memory_order_relaxed);
+                            if (targets[a] >= hubStart)
+                                hubs[targets[a] - hubStart]++;
+                            else
+                                counts[targets[a]].fetch_add(1, memory_order_relaxed);
+                            a++;
+                            b++;
+                        }
+                    }
+                }
+                if (found > 0)
+                    counts[r].fetch_add(found, memory_order_relaxed);
+                total += found;
+            }
+        }
+        localTotals[t] = total;
+    };
+
+    vector<thread> pool;
+    for (unsigned t = 1; t < threads; t++)
+        pool.push_back(thread(worker, t));
+    worker(0);
+    for (size_t t = 0; t < pool.size(); t++)
+        pool[t].join();
+
+    long long triples = 0;
+    for (unsigned t = 0; t < threads; t++)
+    {
+        stats.totalTriangles += localTotals[t];
+        for (int r = hubStart; r < n; r++)
+            counts[r].fetch_add(hubCounts[t][r - hubStart], memory_order_relaxed);
+    }
+    for (int v = 0; v < n; v++)
+        stats.triangles[v] = counts[rank[v]].load(memory_order_relaxed);
+
+    for (int v = 0; v < n; v++)
+    {
+        long long pairs = degree[v] * (degree[v] - 1) / 2;
+        triples += pairs;
+        if (pairs > 0)
+            stats.clustering[v] = (double)stats.triangles[v] / pairs;
+        stats.averageClustering += stats.clustering[v];
+    }
+    if (n > 0)
+        stats.averageClustering /= n;
+    if (triples > 0)
+        stats.globalClustering = 3.0 * stats.totalTriangles / triples;
+
+    return stats;
+}
+
+void SocialNetwork::displayClusteringCoefficient(const string &person)
+{
+    int idx = isnodefound(Node(person));
+    if (idx == -1)
+    {
+        cout << "Person not found in the network.";
+        return;
+    }
+
+    TriangleStatistics stats = triangleStatistics();
+    cout << stats.triangles[idx] << " triangles, clustering coefficient " << stats.clustering[idx];
+}
+
+// ==============================
+// MinHash Sketch Implementation
+// ==============================
+
+void SocialNetwork::rebuildSketch(int idx)
+{
+    vector<uint64_t> &sketch = friendSketches[idx];
+    const vector<int> &friends = adjacencyList[idx];
+    sketch.clear();
+    for (size_t i = 0; i < friends.size(); i++)
+    {
+        sketch.push_back(personHash[friends[i]]);
+    }
+
+    if (sketch.size() > sketchSize)
+    {
+        nth_element(sketch.begin(), sketch.begin() + sketchSize, sketch.end());
+        sketch.resize(sketchSize);
+    }
+    sort(sketch.begin(), sketch.end());
+}
+
+void SocialNetwork::insertIntoSketch(int idx, uint64_t hash)
+{
+    vector<uint64_t> &sketch = friendSketches[idx];
+    if (sketchSize == 0 || (sketch.size() == sketchSize && hash >= sketch.back()))
+        return;
+
+    sketch.insert(upper_bound(sketch.begin(), sketch.end(), hash), hash);
+    if (sketch.size() > sketchSize)
+        sketch.pop_back();
+}
+
+void SocialNetwork::removeFromSketch(int idx, uint64_t hash)
+{
+    vector<uint64_t> &sketch = friendSketches[idx];
+    vector<uint64_t>::iterator it = lower_bound(sketch.begin(), sketch.end(), hash);
+    if (it == sketch.end() || *it != hash)
+        return;
+
+    sketch.erase(it);
+
+    // The next-smallest hash among the remaining friends is unknown, so refill
+    if (sketch.size() < min(sketchSize, adjacencyList[idx].size()))
+        rebuildSketch(idx);
+}
+
+double SocialNetwork::sketchJaccard(int idxA, int idxB) const
+{
+    const vector<uint64_t> &a = friendSketches[idxA];
+    const vector<uint64_t> &b = friendSketches[idxB];
+
+    // Sketches that hold whole friend sets give the exact ratio over the full union;
+    // otherwise the share of the union's bottom-k found in both sketches estimates J
+    bool complete = a.size() == adjacencyList[idxA].size() && b.size() == adjacencyList[idxB].size();
+    size_t limit = complete ? a.size() + b.size() : sketchSize;
+    size_t i = 0, j = 0, seen = 0, both = 0;
+    while (seen < limit && (i < a.size() || j < b.size()))
+    {
+        if (j == b.size() || (i < a.size() && a[i] < b[j]))
+            i++;
+        else if (i == a.size() || b[j] < a[i])
+            j++;
+        else
+        {
+            both++;
+            i++;
+            j++;
+        }
+        seen++;
+    }
+    return seen == 0 ? 0.0 : (double)both / seen;
+}
+
+double SocialNetwork::sketchCommonFriends(int idxA, int idxB) const
+{
+    double jaccard = sketchJaccard(idxA, idxB);
+    double degrees = adjacencyList[idxA].size() + adjacencyList[idxB].size();
+    return jaccard * degrees / (1.0 + jaccard);
+}
+
+void SocialNetwork::setApproximateRecommendations(size_t sketchSize, size_t degreeThreshold)
+{
+    this->approximateDegreeThreshold = degreeThreshold;
+    if (this->sketchSize == sketchSize)
+        return;
+
+    this->sketchSize = sketchSize;
     for (size_t i = 0; i < nodesList.size(); i++)
     {
-        cout << nodesList[i].getName() << ":";
-        for (const Edge &edge : edgeList)
+        rebuildSketch(i);
+    }
+}
+
+double SocialNetwork::estimatedJaccard(const string &personA, const string &personB) const
+{
+    int idxA = isnodefound(Node(personA));
+    int idxB = isnodefound(Node(personB));
+    if (idxA == -1 || idxB == -1)
+        return 0.0;
+    return sketchJaccard(idxA, idxB);
+}
+
+int SocialNetwork::estimatedCommonFriends(const string &personA, const string &personB) const
+{
+    int idxA = isnodefound(Node(personA));
+    int idxB = isnodefound(Node(personB));
+    if (idxA == -1 || idxB == -1)
+        return 0;
+    return (int)(sketchCommonFriends(idxA, idxB) + 0.5);
+}
+
+vector<SocialNetwork::Node> SocialNetwork::approximateTopKPeople(const string &person, int k) const
+{
+    vector<Node> recommendations;
+    int targetIdx = isnodefound(Node(person));
+    if (targetIdx == -1 || k <= 0)
+    {
+        return recommendations;
+    }
+
+    const vector<int> &friends = adjacencyList[targetIdx];
+    const vector<uint64_t> &sketch = friendSketches[targetIdx];
+    if (sketch.empty())
+    {
+        return recommendations;
+    }
+    uint64_t sampleCutoff = sketch.back();
+
+    vector<bool> excluded(nodesList.size(), false);
+    excluded[targetIdx] = true;
+    for (size_t i = 0; i < friends.size(); i++)
+    {
+        excluded[friends[i]] = true;
+    }
+
+    // Two-hop count restricted to the friends whose hash made it into the sketch,
+    // which are a uniform sample of all the person's friends
+    vector<int> sampleHits(nodesList.size(), 0);
+    vector<int> candidates;
+    size_t sampled = 0;
+    for (size_t i = 0; i < friends.size(); i++)
+    {
+        if (friends[i] == targetIdx || personHash[friends[i]] > sampleCutoff)
+            continue;
+
+        sampled++;
+        const vector<int> &friendsOfFriend = adjacencyList[friends[i]];
+        for (size_t j = 0; j < friendsOfFriend.size(); j++)
+        {
+            int candidate = friendsOfFriend[j];
+            if (excluded[candidate])
+                continue;
+            if (sampleHits[candidate]++ == 0)
+                candidates.push_back(candidate);
+        }
+    }
+
+    // Shortlist the most-hit candidates, then refine their scores: exactly for people
+    // with at most sketchSize friends, by scaling the sample hits up otherwise
+    size_t shortlist = min(candidates.size(), max((size_t)k * 8, sketchSize));
+    partial_sort(candidates.begin(), candidates.begin() + shortlist, candidates.end(),
+                 [&sampleHits](int a, int b)
+                 {
+                     if (sampleHits[a] != sampleHits[b])
+                         return sampleHits[a] > sampleHits[b];
+                     return a < b;
+                 });
+
+    double scale = sampled == 0 ? 0.0 : (double)friends.size() / sampled;
+    vector<pair<double, int>> scored;
+    scored.reserve(shortlist);
+    for (size_t i = 0; i < shortlist; i++)
+    {
+        int candidate = candidates[i];
+        const vector<int> &candidateFriends = adjacencyList[candidate];
+        double score = sampleHits[candidate] * scale;
+        if (candidateFriends.size() <= sketchSize)
         {
-            if (edge.getNode1() == nodesList[i] || edge.getNode2() == nodesList[i])
+            score = 0;
+            for (size_t j = 0; j < candidateFriends.size(); j++)
             {
-                if (edge.getNode1() == nodesList[i])
-                    cout << edge.getNode2().getName() << " ";
-                else
-                    cout << edge.getNode1().getName() << " ";
+                if (excluded[candidateFriends[j]] && candidateFriends[j] != targetIdx)
+                    score++;
             }
         }
-        cout << endl;
+        scored.push_back(make_pair(score, candidate));
+    }
+
+    size_t count = min((size_t)k, scored.size());
+    partial_sort(scored.begin(), scored.begin() + count, scored.end(),
+                 [](const pair<double, int> &a, const pair<double, int> &b)
+                 {
+                     if (a.first != b.first)
+                         return a.first > b.first;
+                     return a.second < b.second;
+                 });
+
+    for (size_t i = 0; i < count; i++)
+    {
+        recommendations.push_back(nodesList[scored[i].second]);
     }
-}
\ No newline at end of file
+    return recommendations;
+}
+
+// ==============================
+// Export Implementation
+// ==============================
+
+/**
+ * @brief Reusable meeting point for a fixed group of threads.
+ *
+ * Each wait() blocks until every thread of the group has called it, then releases
+ * them all and resets for the next round (C++11 has no std::barrier).
+ */
+class IterationBarrier
+{
+    mutex lock;                  ///< Guards every member below
+    condition_variable released; ///< Signaled when the last thread of a round arrives
+    unsigned parties;            ///< Number of threads in the group
+    unsigned waiting;            ///< Threads that have arrived in the current round
+    unsigned long round;         ///< Number of completed rounds
+
+public:
+    explicit IterationBarrier(unsigned parties) : parties(parties), waiting(0), round(0) {}
+
+    void wait()
+    {
+        unique_lock<mutex> guard(lock);
+        unsigned long arrivedIn = round;
+        if (++waiting == parties)
+        {
+            waiting = 0;
+            round++;
+            released.notify_all();
+            return;
+        }
+        released.wait(guard, [this, arrivedIn]()
+                      { return round != arrivedIn; });
+    }
+};
+
+/**
+ * @brief Size at which an export buffer is handed to the output stream.
+ */
+static const size_t EXPORT_BUFFER_SIZE = 1 << 20;
+
+/**
+ * @brief Number of people rendered by one thread before the buffers are written out.
+ */
+static const size_t EXPORT_CHUNK_SIZE = 4096;
+
+/**
+ * @brief Appends a name to a CSV buffer, quoting it if it holds a separator or quote.
+ */
+static void appendCsvField(string &buffer, const string &field)
+{
+    if (field.find_first_of(",\"\r\n") == string::npos)
+    {
+        buffer += field;
+        return;
+    }
+
+    buffer += '"';
+    for (size_t i = 0; i < field.size(); i++)
+    {
+        if (field[i] == '"')
+            buffer += '"';
+        buffer += field[i];
+    }
+    buffer += '"';
+}
+
+/**
+ * @brief Appends a name to a DOT buffer as a quoted, escaped identifier.
+ */
+static void appendDotId(string &buffer, const string &id)
+{
+    buffer += '"';
+    for (size_t i = 0; i < id.size(); i++)
+    {
+        if (id[i] == '"' || id[i] == '\\')
+            buffer += '\\';
+        buffer += id[i];
+    }
+    buffer += '"';
+}
+
+void SocialNetwork::renderExport(string &buffer, ExportFormat format, size_t firstId, size_t lastId) const
+{
+    for (size_t id = firstId; id < lastId; id++)
+    {
+        const string &name = nodesList[id].getName();
+        const vector<int> &friends = adjacencyList[id];
+
+        switch (format)
+        {
+        case TEXT_FORMAT:
+            buffer += name;
+            buffer += ':';
+            for (size_t i = 0; i < friends.size(); i++)
+            {
+                buffer += ' ';
+                buffer += nodesList[friends[i]].getName();
+            }
+            buffer += '\n';
+            break;
+
+        case CSV_FORMAT:
+            for (size_t i = 0; i < friends.size(); i++)
+            {
+                if (friends[i] < (int)id)
+                    continue;
+                appendCsvField(buffer, name);
+                buffer += ',';
+                appendCsvField(buffer, nodesList[friends[i]].getName());
+                buffer += '\n';
+            }
+            break;
+
+        case DOT_FORMAT:
+            buffer += "  ";
+            appendDotId(buffer, name);
+            buffer += ";\n";
+            for (size_t i = 0; i < friends.size(); i++)
+            {
+                if (friends[i] < (int)id)
+                    continue;
+                buffer += "  ";
+                appendDotId(buffer, name);
+                buffer += " -- ";
+                appendDotId(buffer, nodesList[friends[i]].getName());
+                buffer += ";\n";
+            }
+            break;
+        }
+    }
+}
+
+size_t SocialNetwork::exportNetwork(ostream &out, ExportFormat format, size_t firstId, size_t count, unsigned threads) const
+{
+    size_t lastId = nodesList.size();
+    if (firstId > lastId)
+        firstId = lastId;
+    if (count != 0 && firstId + count < lastId)
+        lastId = firstId + count;
+
+    if (threads == 0)
+        threads = max(1u, thread::hardware_concurrency());
+
+    string header;
+    if (format == CSV_FORMAT)
+        header = "person,friend\n";
+    else if (format == DOT_FORMAT)
+        header = "graph SocialNetwork {\n";
+    out.write(header.data(), header.size());
+
+    if (threads == 1)
+    {
+        string buffer;
+        buffer.reserve(EXPORT_BUFFER_SIZE + EXPORT_BUFFER_SIZE / 4);
+        for (size_t id = firstId; id < lastId;)
+        {
+            // Render until the buffer is full, then write it out in one go
+            while (id < lastId && buffer.size() < EXPORT_BUFFER_SIZE)
+            {
+                size_t chunkEnd = min(id + 64, lastId);
+                renderExport(buffer, format, id, chunkEnd);
+                id = chunkEnd;
+            }
+            out.write(buffer.data(), buffer.size());
+            buffer.clear();
+        }
+    }
+    else
+    {
+        // Each round, thread t renders the t-th chunk of IDs into its buffer of the
+        // round's set, and this thread writes the chunks out in order. Rounds alternate
+        // between two sets, so the next round renders while the last one is written;
+        // a set is only reused once the barrier shows it has been written
+        size_t stride = threads * EXPORT_CHUNK_SIZE;
+        vector<string> buffers[2] = {vector<string>(threads), vector<string>(threads)};
+        IterationBarrier barrier(threads + 1);
+
+        auto worker = [this, &buffers, &barrier, format, firstId, lastId, stride](unsigned t)
+        {
+            int set = 0;
+            for (size_t roundStart = firstId; roundStart < lastId; roundStart += stride)
+            {
+                size_t chunkStart = min(roundStart + t * EXPORT_CHUNK_SIZE, lastId);
+                size_t chunkEnd = min(chunkStart + EXPORT_CHUNK_SIZE, lastId);
+                buffers[set][t].clear();
+                renderExport(buffers[set][t], format, chunkStart, chunkEnd);
+                barrier.wait();
+                set ^= 1;
+            }
+        };
+
+        vector<thread> pool;
+        for (unsigned t = 0; t < threads; t++)
+            pool.push_back(thread(worker, t));
+
+        int set = 0;
+        for (size_t roundStart = firstId; roundStart < lastId; roundStart += stride)
+        {
+            barrier.wait();
+            for (unsigned t = 0; t < threads; t++)
+                out.write(buffers[set][t].data(), buffers[set][t].size());
+            set ^= 1;
+        }
+        for (unsigned t = 0; t < threads; t++)
+            pool[t].join();
+    }
+
+    if (format == DOT_FORMAT)
+        out.write("}\n", 2);
+    return lastId;
+}
+
+int SocialNetwork::importNetwork(istream &in)
+{
+    int malformed = 0;
+    string line;
+    while (getline(in, line))
+    {
+        if (!line.empty() && line[line.size() - 1] == '\r')
+            line.erase(line.size() - 1);
+        if (line.find_first_not_of(" \t") == string::npos)
+            continue;
+
+        size_t colon = line.find(':');
+        if (colon == string::npos)
+        {
+            malformed++;
+            continue;
+        }
+
+        string person = line.substr(0, colon);
+        person.erase(person.find_last_not_of(" \t") + 1);
+        person.erase(0, person.find_first_not_of(" \t"));
+        if (person.empty())
+        {
+            malformed++;
+            continue;
+        }
+        addPerson(person);
+
+        size_t pos = colon + 1;
+        while (pos < line.size())
+        {
+            size_t start = line.find_first_not_of(" \t", pos);
+            if (start == string::npos)
+                break;
+            size_t end = line.find_first_of(" \t", start);
+            if (end == string::npos)
+                end = line.size();
+
+            string friendName = line.substr(start, end - start);
+            addPerson(friendName);
+            addFriend(person, friendName);
+            pos = end;
+        }
+    }
+    return malformed;
+}
+
+// ==============================
+// Influence Ranking Implementation
+// ==============================
+
+SocialNetwork::InfluenceUpdate SocialNetwork::updateInfluence(unsigned threads, bool warmStart)
+{
+    int n = nodesList.size();
+    InfluenceUpdate update;
+    update.iterations = 0;
+    update.residual = 0.0;
+    update.warmStart = warmStart && influenceReady && n > 0;
+
+    // Start from the previous ranking (rescaled, since people may have come and gone)
+    // or from a uniform one
+    vector<double> &scores = influenceScores;
+    double total = 0.0;
+    if (update.warmStart)
+    {
+        for (int v = 0; v < n; v++)
+            total += scores[v];
+    }
+    if (total > 0.0)
+    {
+        for (int v = 0; v < n; v++)
+            scores[v] /= total;
+    }
+    else
+    {
+        update.warmStart = false;
+        scores.assign(n, n > 0 ? 1.0 / n : 0.0);
+    }
+    influenceReady = true;
+    influenceStale = false;
+    if (n == 0)
+        return update;
+
+    // Flat copy of the adjacency so each pull streams through one array
+    vector<size_t> offsets(n + 1, 0);
+    for (int v = 0; v < n; v++)
+        offsets[v + 1] = offsets[v] + adjacencyList[v].size();
+    vector<int> targets(offsets[n]);
+    for (int v = 0; v < n; v++)
+        copy(adjacencyList[v].begin(), adjacencyList[v].end(), targets.begin() + offsets[v]);
+
+    if (threads == 0)
+        threads = max(1u, thread::hardware_concurrency());
+    threads = min<unsigned>(threads, n);
+
+    // Thread t owns IDs [bounds[t], bounds[t + 1]), cut so each gets a similar
+    // share of people plus friendships
+    vector<int> bounds(threads + 1, n);
+    bounds[0] = 0;
+    for (unsigned t = 1; t < threads; t++)
+    {
+        size_t share = (offsets[n] + n) * t / threads;
+        int lo = bounds[t - 1], hi = n;
+        while (lo < hi)
+        {
+            int mid = lo + (hi - lo) / 2;
+            if (offsets[mid] + mid < share)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        bounds[t] = lo;
+    }
+
+    vector<double> nextScores(n);
+    vector<double> contribution(n), nextContribution(n);
+    double dangling = 0.0;
+    for (int v = 0; v < n; v++)
+    {
+        contribution[v] = scores[v] * inverseDegree[v];
+        if (friendCount[v] == 0)
+            dangling += scores[v];
+    }
+
+    // The workers are started once and meet at the barrier twice per iteration: after
+    // computing their ranges, and after thread 0 has swapped the buffers, summed the
+    // partial results and decided whether to go on
+    vector<double> localResidual(threads), localDangling(threads);
+    const double damping = influenceDamping;
+    double base = (1.0 - damping) / n + damping * dangling / n;
+    bool done = influenceMaxIterations <= 0;
+    IterationBarrier barrier(threads);
+
+    auto worker = [&](unsigned t)
+    {
+        while (!done)
+        {
+            double residual = 0.0, danglingScore = 0.0;
+            for (int v = bounds[t]; v < bounds[t + 1]; v++)
+            {
+                double pulled = 0.0;
+                for (size_t i = offsets[v]; i < offsets[v + 1]; i++)
+                    pulled += contribution[targets[i]];
+
+                double score = base + damping * pulled;
+                residual += fabs(score - scores[v]);
+                nextScores[v] = score;
+                nextContribution[v] = score * inverseDegree[v];
+                if (friendCount[v] == 0)
+                    danglingScore += score;
+            }
+            localResidual[t] = residual;
+            localDangling[t] = danglingScore;
+            barrier.wait();
+
+            if (t == 0)
+            {
+                scores.swap(nextScores);
+                contribution.swap(nextContribution);
+                update.residual = 0.0;
+                dangling = 0.0;
+                for (unsigned i = 0; i < threads; i++)
+                {
+                    update.residual += localResidual[i];
+                    dangling += localDangling[i];
+                }
+                update.iterations++;
+                base = (1.0 - damping) / n + damping * dangling / n;
+                done = update.residual < influenceTolerance || update.iterations >= influenceMaxIterations;
+            }
+            barrier.wait();
+        }
+    };
+
+    vector<thread> pool;
+    for (unsigned t = 1; t < threads; t++)
+        pool.push_back(thread(worker, t));
+    worker(0);
+    for (size_t t = 0; t < pool.size(); t++)
+        pool[t].join();
+    return update;
+}
+
+void SocialNetwork::setInfluenceParameters(double damping, double tolerance, int maxIterations)
+{
+    influenceDamping = damping;
+    influenceTolerance = tolerance;
+    influenceMaxIterations = maxIterations;
+    influenceStale = true;
+}
+
+double SocialNetwork::influence(const string &person)
+{
+    int idx = isnodefound(Node(person));
+    if (idx == -1)
+        return 0.0;
+    if (influenceStale)
+        updateInfluence();
+    return influenceScores[idx];
+}
+
+vector<SocialNetwork::Node> SocialNetwork::topInfluencers(int k)
+{
+    vector<Node> result;
+    if (k <= 0)
+        return result;
+    if (influenceStale)
+        updateInfluence();
+
+    vector<int> ranked(nodesList.size());
+    for (size_t i = 0; i < ranked.size(); i++)
+        ranked[i] = i;
+    size_t keep = min(ranked.size(), (size_t)k);
+    const vector<double> &scores = influenceScores;
+    partial_sort(ranked.begin(), ranked.begin() + keep, ranked.end(), [&scores](int a, int b)
+                 { return scores[a] > scores[b] || (scores[a] == scores[b] && a < b); });
+
+    for (size_t i = 0; i < keep; i++)
+        result.push_back(nodesList[ranked[i]]);
+    return result;
+}
+
+void SocialNetwork::displayTopInfluencers(int k)
+{
+    vector<Node> influencers = topInfluencers(k);
+    if (influencers.empty())
+    {
+        cout << "No people in the network.";
+        return;
+    }
+    for (size_t i = 0; i < influencers.size(); i++)
+    {
+        int idx = isnodefound(influencers[i]);
+        cout << influencers[i].getName() << " (" << influenceScores[idx] << ") ";
+    }
+}
@@ -4,6 +4,10 @@
 #include <vector>
 #include <string>
 #include <iostream>
+#include <utility>
+#include <unordered_map>
+#include <cstdint>
+#include <chrono>
 
 using namespace std;
 
@@ -109,7 +113,136 @@ private:
      */
     vector<Node> nodesList;
 
+    /**
+     * @brief Adjacency index mirroring edgeList
+     *
+     * adjacencyList[i] holds the nodesList indices of every friend of nodesList[i],
+     * in the order the friendships were created. Every mutating method keeps it in
+     * sync with edgeList, so neighbor lookups cost O(degree) instead of a full scan
+     * of the edge list.
+     */
+    vector<vector<int>> adjacencyList;
+
+    /**
+     * @brief Maps each person's name to their index in nodesList
+     *
+     * Lets isnodefound resolve a name in O(1) instead of scanning nodesList.
+     * Indices above a deleted person's are shifted down along with nodesList.
+     */
+    unordered_map<string, int> nodeIndex;
+
+    /**
+     * @brief 64-bit hash of each person's name, indexed like nodesList.
+     */
+    vector<uint64_t> personHash;
+
+    /**
+     * @brief Bottom-k MinHash sketch of each person's friend set
+     *
+     * friendSketches[i] holds the sketchSize smallest personHash values among the
+     * friends of nodesList[i], in ascending order. It is an exact copy of the friend
+     * set while the person has at most sketchSize friends, and a uniform random
+     * sample of it afterwards. addFriend, unfriend and deletePerson keep it current.
+     */
+    vector<vector<uint64_t>> friendSketches;
+
+    size_t sketchSize;                 ///< Number of hashes kept per sketch
+    size_t approximateDegreeThreshold; ///< Friend count from which topKPeople switches to sketches
+
+    /**
+     * @brief Per-person degree tables feeding the recommendation scores
+     *
+     * friendCount[i] = d, inverseDegree[i] = 1 / d and inverseLogDegree[i] = 1 / log(d),
+     * where d is the number of friends of nodesList[i] (0 when undefined). They are
+     * refreshed for the affected people on every change, so the scoring loop never
+     * calls log and reads compact arrays instead of adjacencyList.
+     */
+    vector<int> friendCount;
+    vector<double> inverseDegree;    ///< See friendCount
+    vector<double> inverseLogDegree; ///< See friendCount
+
+    /**
+     * @brief Influence (PageRank) score of each person, indexed like nodesList
+     *
+     * Once computed, addPerson and deletePerson keep it aligned with nodesList and
+     * every change marks it stale; the next update then starts from these scores
+     * instead of from a uniform distribution.
+     */
+    vector<double> influenceScores;
+
+    bool influenceReady;           ///< True once influenceScores holds a computed ranking
+    bool influenceStale;           ///< True if the network changed since the last update
+    double influenceDamping;       ///< Probability of following a friendship rather than jumping
+    double influenceTolerance;     ///< L1 change below which the iterations stop
+    int influenceMaxIterations;    ///< Iteration cap per update
+
+    /**
+     * @brief Rebuilds nodeIndex, adjacencyList, personHash and friendSketches from
+     * scratch out of nodesList and edgeList.
+     */
+    void rebuildAdjacency();
+
+    /**
+     * @brief Recomputes one person's entries in friendCount, inverseDegree and inverseLogDegree.
+     * @param idx Index of the person.
+     */
+    void refreshDegreeScores(int idx);
+
+    /**
+     * @brief Recomputes one person's friend sketch from adjacencyList.
+     * @param idx Index of the person.
+     */
+    void rebuildSketch(int idx);
+
+    /**
+     * @brief Adds a friend's hash to a person's sketch if it ranks among the smallest.
+     * @param idx Index of the person.
+     * @param hash personHash of the new friend.
+     */
+    void insertIntoSketch(int idx, uint64_t hash);
+
+    /**
+     * @brief Removes a former friend's hash from a person's sketch, refilling it if needed.
+     * @param idx Index of the person (adjacencyList must already exclude the former friend).
+     * @param hash personHash of the former friend.
+     */
+    void removeFromSketch(int idx, uint64_t hash);
+
+    /**
+     * @brief Estimates the Jaccard similarity of two friend sets from their sketches.
+     * @param idxA Index of the first person.
+     * @param idxB Index of the second person.
+     * @return Estimated |A n B| / |A u B|, in O(sketchSize).
+     */
+    double sketchJaccard(int idxA, int idxB) const;
+
+    /**
+     * @brief Estimates the number of mutual friends of two people from their sketches.
+     * @param idxA Index of the first person.
+     * @param idxB Index of the second person.
+     * @return Estimated |A n B|, derived from the Jaccard estimate and the exact degrees.
+     */
+    double sketchCommonFriends(int idxA, int idxB) const;
+
+    /**
+     * @brief Removes one occurrence of a friendship from adjacencyList.
+     * @param idxA Index of the first person.
+     * @param idxB Index of the second person.
+     */
+    void removeAdjacency(int idxA, int idxB);
+
 public:
+    /**
+     * @brief Default number of hashes kept in each friend sketch.
+     */
+    static const size_t DEFAULT_SKETCH_SIZE = 64;
+
+    /**
+     * @brief Default friend count from which topKPeople uses the approximate mode:
+     * never, so recommendations are exact unless setApproximateRecommendations opts in.
+     */
+    static const size_t DEFAULT_APPROXIMATE_DEGREE = SIZE_MAX;
+
     /**
      * @brief Default constructor. Initializes an empty network.
      */
@@ -130,6 +263,20 @@ public:
      */
     int isnodefound(const Node &node) const;
 
+    /**
+     * @brief Finds a person's ID (their index in the network).
+     * @param person Name of the person.
+     * @return The person's ID, or -1 if they are not in the network.
+     */
+    int personId(const string &person) const;
+
+    /**
+     * @brief Retrieves the name of the person with a given ID.
+     * @param id ID of the person, as returned by personId or the k-hop queries.
+     * @return The person's name, or an empty string if the ID is out of range.
+     */
+    string personName(int id) const;
+
     /**
      * @brief Adds a person to the network.
      * @param person The name of the person to add.
@@ -165,7 +312,6 @@ public:
      */
     bool areFriends(const string &PersonA, const string &PersonB) const;
 
-private:
     /**
      * @brief Computes the shortest path between two people using Breadth-First Search (BFS).
      * @param begin Name of the starting person.
@@ -177,6 +323,53 @@ private:
      */
     vector<Node> shortestPath(const string &begin, const string &finish) const;
 
+    /**
+     * @brief Computes the shortest path between two people, giving up at a deadline.
+     * @param begin Name of the starting person.
+     * @param finish Name of the destination person.
+     * @param deadline Point in time after which the search stops partway through.
+     * @param timedOut If not null, set to true if the search was cut short by the
+     *                 deadline and to false if it ran to completion.
+     * @return The path, or empty if unreachable or the deadline passed first.
+     * @note The clock is read once every 1024 people dequeued, so the check costs nothing
+     * measurable on searches that finish in time.
+     */
+    vector<Node> shortestPath(const string &begin, const string &finish, const chrono::steady_clock::time_point &deadline, bool *timedOut = nullptr) const;
+
+    /**
+     * @brief Number of sources traversed together by one multi-source BFS pass (one bit each).
+     */
+    static const size_t MS_BFS_BATCH = 64;
+
+    /**
+     * @brief Computes BFS distances from many sources at once.
+     * @param sources Names of the people to measure distances from.
+     * @return One entry per source; entry i holds the distance from sources[i] to every
+     *         person ID (-1 if unreachable). Unknown sources get all -1.
+     * @note Sources are processed MS_BFS_BATCH at a time with bit-parallel frontiers, so
+     * every edge scan is shared by the whole batch.
+     * Time complexity: O((S / 64) * D * (V + E)) where D is the graph diameter.
+     */
+    vector<vector<int>> multiSourceDistances(const vector<string> &sources) const;
+
+    /**
+     * @brief Answers many shortest-path queries in one batch.
+     * @param queries Pairs of (starting person, destination person).
+     * @return One path per query, with the same conventions as shortestPath.
+     * @note Queries are grouped by starting person and the distinct sources are run
+     * through the multi-source BFS, so queries sharing a source cost nothing extra.
+     */
+    vector<vector<Node>> shortestPaths(const vector<pair<string, string>> &queries) const;
+
+private:
+    /**
+     * @brief Runs one bit-parallel BFS pass for up to MS_BFS_BATCH sources (MS-BFS).
+     * @param sources IDs of the source people; bit i of every word belongs to sources[i].
+     * @param distances If not null, receives one distance row per source (-1 if unreachable).
+     * @param parents If not null, receives one BFS parent row per source (-1 for none).
+     */
+    void multiSourceBFS(const vector<int> &sources, vector<vector<int>> *distances, vector<vector<int>> *parents) const;
+
     /**
      * @brief Finds the shortest path while avoiding specific people.
      * @param begin Name of the starting person.
@@ -194,21 +387,102 @@ private:
      */
     int nbOfCommonFriends(const Node &node1, const Node &node2) const;
 
+    /**
+     * @brief Scoring policies for rankRecommendations (defined in SocialNetwork.cpp).
+     *
+     * Each policy provides a Score type, the weight a shared friend contributes
+     * (weight), and the final score given the summed weights and both degrees
+     * (finalize), of type Rank. usesCandidateDegree tells whether finalize reads the
+     * candidate's degree, so the loop only loads it when it is needed. Everything is
+     * static so the compiler inlines it into the loop.
+     */
+    struct MutualFriendsScore;
+    struct AdamicAdarScore;
+    struct ResourceAllocationScore;
+    struct JaccardScore;
+
+    /**
+     * @brief Exact two-hop recommendation engine, specialized for one scoring policy.
+     * @tparam Scorer One of the scoring policies above.
+     * @param targetIdx Index of the person to recommend for.
+     * @param k Number of recommendations.
+     * @return The k best non-friends, highest score first (ties broken by ID).
+     */
+    template <class Scorer>
+    vector<Node> rankRecommendations(int targetIdx, int k) const;
+
+public:
+    /**
+     * @brief How topKPeople scores a potential friend reached through shared friends.
+     */
+    enum RecommendationPolicy
+    {
+        MUTUAL_FRIENDS,      ///< Number of mutual friends
+        ADAMIC_ADAR,         ///< Sum of 1 / log(degree) over mutual friends
+        RESOURCE_ALLOCATION, ///< Sum of 1 / degree over mutual friends
+        JACCARD              ///< Mutual friends / friends of either person
+    };
+
     /**
      * @brief Recommends top-K potential friends for a person based on mutual connections.
      * @param person Name of the person to recommend for.
      * @param k Number of recommendations.
-     * @return List of recommended people (nodes).
+     * @param policy How candidates are scored.
+     * @return List of recommended people (nodes), best score first.
+     * @note Walks the friends of the person's friends once, using a version of the loop
+     * compiled for the chosen policy. Time complexity: O(sum of the friends' degrees + V).
+     * Once setApproximateRecommendations has lowered approximateDegreeThreshold, people
+     * with at least that many friends are answered by approximateTopKPeople instead, with
+     * MUTUAL_FRIENDS only; the other policies always stay exact.
      */
-    vector<Node> topKPeople(const string &person, int k);
+    vector<Node> topKPeople(const string &person, int k, RecommendationPolicy policy = MUTUAL_FRIENDS) const;
+
+    /**
+     * @brief Recommends top-K potential friends using the MinHash friend sketches.
+     * @param person Name of the person to recommend for.
+     * @param k Number of recommendations.
+     * @return List of recommended people, highest estimated mutual friend count first.
+     * @note The friends whose hash is in the person's sketch form a uniform sample of
+     * size sketchSize; only their friends are visited, counting how often each
+     * candidate is reached. The best-hit candidates are then rescored, exactly when
+     * they have at most sketchSize friends and by scaling the hit count up otherwise.
+     * The two-hop walk thus shrinks by a factor of degree / sketchSize.
+     */
+    vector<Node> approximateTopKPeople(const string &person, int k) const;
+
+    /**
+     * @brief Tunes the approximate recommendation mode (accuracy vs. latency).
+     * @param sketchSize Number of hashes kept per friend sketch; larger is more accurate
+     *                   and slower. Changing it rebuilds every sketch.
+     * @param degreeThreshold Friend count from which topKPeople switches to
+     *                        approximateTopKPeople, for MUTUAL_FRIENDS only. Pass
+     *                        DEFAULT_APPROXIMATE_DEGREE (SIZE_MAX) to turn it off.
+     */
+    void setApproximateRecommendations(size_t sketchSize, size_t degreeThreshold);
+
+    /**
+     * @brief Estimates the Jaccard similarity of two people's friend sets.
+     * @param personA Name of the first person.
+     * @param personB Name of the second person.
+     * @return Estimated similarity in [0, 1]; exact while both have at most sketchSize friends.
+     */
+    double estimatedJaccard(const string &personA, const string &personB) const;
+
+    /**
+     * @brief Estimates the number of mutual friends of two people.
+     * @param personA Name of the first person.
+     * @param personB Name of the second person.
+     * @return Estimated mutual friend count; exact while both have at most sketchSize friends.
+     */
+    int estimatedCommonFriends(const string &personA, const string &personB) const;
 
-public:
     /**
      * @brief Displays the top-K friend recommendations for a given person.
      * @param person Name of the person.
      * @param k Number of suggestions.
+     * @param policy How candidates are scored.
      */
-    void displayTopKPeople(const string &person, int k);
+    void displayTopKPeople(const string &person, int k, RecommendationPolicy policy = MUTUAL_FRIENDS);
 
     /**
      * @brief Displays the shortest path between two people.
@@ -227,15 +501,232 @@ public:
 
     /**
      * @brief Displays the entire social network (people and their connections).
+     * @note Uses the TEXT_FORMAT export, one "Name: Friend1 Friend2" line per person.
      */
     void displaySocialNetWork();
 
+    /**
+     * @brief Output formats supported by exportNetwork.
+     */
+    enum ExportFormat
+    {
+        TEXT_FORMAT, ///< "A: B E F" adjacency lines, as in the Edge List files
+        CSV_FORMAT,  ///< "person,friend" header, then each friendship once
+        DOT_FORMAT   ///< Graphviz undirected graph, each friendship once
+    };
+
+    /**
+     * @brief Streams people and friendships to an output stream.
+     *
+     * Works straight off adjacencyList in O(V + E). Output is built in large buffers
+     * that are handed to the stream in a few big writes, with no per-line flushing.
+     * With several threads, consecutive ID ranges are rendered in parallel by workers
+     * started once per export, and written in order by the calling thread, so the
+     * output is identical to a single-threaded export.
+     *
+     * @param out Destination stream.
+     * @param format Output format.
+     * @param firstId ID of the first person to export (for paginated dumps).
+     * @param count Number of people to export (0 = everyone from firstId on).
+     * @param threads Number of rendering threads (0 = one per hardware core).
+     * @return ID following the last exported person (the firstId of the next page).
+     * @note In CSV and DOT, a friendship belongs to the page of its lower-ID person. DOT
+     * pages are complete graphs on their own, with every page's people declared.
+     */
+    size_t exportNetwork(ostream &out, ExportFormat format, size_t firstId = 0, size_t count = 0, unsigned threads = 1) const;
+
+    /**
+     * @brief Loads people and friendships written in TEXT_FORMAT.
+     *
+     * Each "Name: Friend1 Friend2" line adds the person and any unknown friends, then
+     * the friendships, so the Edge List files and TEXT_FORMAT exports round-trip.
+     * Blank lines are skipped.
+     *
+     * @param in Source stream.
+     * @return Number of lines that could not be parsed (no ':' separator or no name
+     *         before it); they are skipped.
+     */
+    int importNetwork(istream &in);
+
+private:
+    /**
+     * @brief Appends the export of a range of people to a buffer.
+     * @param buffer Buffer to append to.
+     * @param format Output format.
+     * @param firstId ID of the first person to render.
+     * @param lastId ID following the last person to render.
+     */
+    void renderExport(string &buffer, ExportFormat format, size_t firstId, size_t lastId) const;
+
+public:
     /**
      * @brief Retrieves all friends (neighbors) of a given person.
      * @param node The person whose friends to retrieve.
      * @return List of neighboring nodes.
      */
     vector<Node> getNeighbors(const Node &node) const;
+
+    /**
+     * @brief Streams the people reachable from a person within k hops, one at a time.
+     *
+     * The cursor walks the neighborhood level by level (BFS order), so people at
+     * distance 1 come out before people at distance 2, and so on. Only the frontier
+     * and a visited bitmap are kept in memory; the result itself is never
+     * materialized. A cursor is invalidated by any change to the network.
+     */
+    class KHopCursor
+    {
+        friend class SocialNetwork;
+
+        const SocialNetwork *network; ///< Network being traversed
+        vector<bool> visited;         ///< People already reached (or blacklisted)
+        vector<int> frontier;         ///< People at distance hop
+        vector<int> nextFrontier;     ///< People discovered at distance hop + 1
+        size_t frontierPos;           ///< Position of the person being expanded
+        size_t neighborPos;           ///< Position inside that person's friend list
+        int hop;                      ///< Distance of the current frontier
+        int maxHops;                  ///< Maximum distance to report
+        size_t limit;                 ///< Maximum number of people to report (0 = no limit)
+        size_t emitted;               ///< Number of people reported so far
+
+        KHopCursor(const SocialNetwork *network, int maxHops, size_t limit);
+
+    public:
+        /**
+         * @brief Advances to the next reachable person.
+         * @param id Receives the ID of the person.
+         * @param distance Receives the number of hops between the source and that person.
+         * @return False once the neighborhood (or the result limit) is exhausted.
+         */
+        bool next(int &id, int &distance);
+    };
+
+    /**
+     * @brief Opens a streaming k-hop query.
+     * @param person Name of the person at the center of the neighborhood.
+     * @param k Maximum number of hops.
+     * @param blacklister People that must not be reported or traversed through.
+     * @param limit Stop after this many people (0 = no limit).
+     * @return A cursor over the neighborhood; empty if the person is unknown or blacklisted.
+     */
+    KHopCursor kHopCursor(const string &person, int k, const vector<string> &blacklister = vector<string>(), size_t limit = 0) const;
+
+    /**
+     * @brief Collects the IDs of everyone within k hops of a person.
+     * @param person Name of the person at the center of the neighborhood.
+     * @param k Maximum number of hops.
+     * @param blacklister People that must not be reported or traversed through.
+     * @param limit Stop after this many people (0 = no limit). Closer people are kept first.
+     * @param hopCounts If not null, receives one entry per distance reached, where
+     *                  hopCounts[d - 1] is the number of people reported at distance d.
+     * @return Sorted list of person IDs, excluding the person themself.
+     * @note Time complexity: O(V + E) in the worst case, but only the explored part
+     * of the graph is touched apart from the O(V) visited bitmap.
+     */
+    vector<int> kHopNeighborhood(const string &person, int k, const vector<string> &blacklister = vector<string>(), size_t limit = 0, vector<int> *hopCounts = nullptr) const;
+
+    /**
+     * @brief Computes the k-hop neighborhood of a person as a membership bitmap.
+     * @param person Name of the person at the center of the neighborhood.
+     * @param k Maximum number of hops.
+     * @param blacklister People that must not be reported or traversed through.
+     * @return A bitmap indexed by person ID; entry i is true if person i is within k hops.
+     */
+    vector<bool> kHopBitmap(const string &person, int k, const vector<string> &blacklister = vector<string>()) const;
+
+    /**
+     * @brief Displays everyone within k hops of a person, along with per-hop counts.
+     * @param person Name of the person.
+     * @param k Maximum number of hops.
+     */
+    void displayKHopNeighborhood(const string &person, int k);
+
+    /**
+     * @brief Result of a triangle count over the whole network.
+     */
+    struct TriangleStatistics
+    {
+        long long totalTriangles;  ///< Number of distinct triangles (groups of three mutual friends)
+        vector<long long> triangles; ///< triangles[id] = number of triangles the person belongs to
+        vector<double> clustering;   ///< clustering[id] = local clustering coefficient of the person
+        double averageClustering;    ///< Mean of the local clustering coefficients
+        double globalClustering;     ///< Transitivity: 3 x triangles / connected triples
+    };
+
+    /**
+     * @brief Counts triangles and computes clustering coefficients for every person.
+     *
+     * Friendships are oriented from the lower-degree to the higher-degree person (ties
+     * broken by ID), so each triangle is found exactly once and no person's oriented
+     * list is longer than O(sqrt(E)). Triangles are then found by intersecting sorted
+     * oriented lists, with people handed out to worker threads in small chunks.
+     *
+     * @param threads Number of worker threads (0 = one per hardware core).
+     * @return Global and per-person triangle counts and clustering coefficients.
+     * @note Time complexity: O(E * sqrt(E)) total work. Self-friendships are ignored.
+     */
+    TriangleStatistics triangleStatistics(unsigned threads = 0) const;
+
+    /**
+     * @brief Displays a person's triangle count and local clustering coefficient.
+     * @param person Name of the person.
+     */
+    void displayClusteringCoefficient(const string &person);
+
+    /**
+     * @brief Outcome of an influence update.
+     */
+    struct InfluenceUpdate
+    {
+        int iterations;  ///< Number of iterations run
+        double residual; ///< L1 change of the scores in the last iteration
+        bool warmStart;  ///< True if the previous scores were the starting point
+    };
+
+    /**
+     * @brief Recomputes everyone's influence (PageRank) score.
+     *
+     * Each iteration, every person pulls score / friends from each of their friends
+     * through a flat copy of the adjacency, with ID ranges (balanced by friendship
+     * count) split across threads. Scores and per-person contributions are double
+     * buffered, so an iteration only reads one pair of arrays and writes the other.
+     * People without friends spread their score evenly over everyone. Scores sum to 1.
+     *
+     * @param threads Number of worker threads (0 = one per hardware core).
+     * @param warmStart Start from the previous scores, if any, rather than uniform ones.
+     *                  After a small batch of changes this needs far fewer iterations.
+     * @return Iterations run, final residual, and whether the update was warm.
+     * @note Time complexity: O(V + E) per iteration.
+     */
+    InfluenceUpdate updateInfluence(unsigned threads = 0, bool warmStart = true);
+
+    /**
+     * @brief Sets the influence parameters and marks the scores stale.
+     * @param damping Probability of following a friendship (default 0.85).
+     * @param tolerance L1 change below which the iterations stop (default 1e-6).
+     * @param maxIterations Iteration cap per update (default 200).
+     */
+    void setInfluenceParameters(double damping, double tolerance, int maxIterations);
+
+    /**
+     * @brief Influence score of a person, updating the scores first if the network changed.
+     * @param person Name of the person.
+     * @return The person's score (scores sum to 1), or 0 if they are not in the network.
+     */
+    double influence(const string &person);
+
+    /**
+     * @brief The most influential people, updating the scores first if the network changed.
+     * @param k Number of people to return.
+     * @return Up to k people, highest score first (ties by ID).
+     */
+    vector<Node> topInfluencers(int k);
+
+    /**
+     * @brief Displays the k most influential people with their scores.
+     * @param k Number of people to display.
+     */
+    void displayTopInfluencers(int k);
 };
 
 #endif // SOCIALNETWORK_H
\ No newline at end of file
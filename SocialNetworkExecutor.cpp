@@ -0,0 +1,273 @@
+#include "SocialNetworkExecutor.h"
+#include <memory>
+
+// ==============================
+// Result Helpers
+// ==============================
+
+/**
+ * @brief Runs a request and stores its value in the promise.
+ */
+template <class R>
+static void fulfill(promise<R> &result, function<R()> &request)
+{
+    result.set_value(request());
+}
+
+/**
+ * @brief Runs a request that has no value and marks the promise as ready.
+ */
+static void fulfill(promise<void> &result, function<void()> &request)
+{
+    request();
+    result.set_value();
+}
+
+template <class NodeList>
+vector<string> SocialNetworkExecutor::namesOf(const NodeList &nodes)
+{
+    vector<string> names;
+    names.reserve(nodes.size());
+    for (size_t i = 0; i < nodes.size(); i++)
+    {
+        names.push_back(nodes[i].getName());
+    }
+    return names;
+}
+
+chrono::steady_clock::time_point SocialNetworkExecutor::deadlineAfter(chrono::milliseconds timeout)
+{
+    if (timeout.count() <= 0)
+        return chrono::steady_clock::time_point::max();
+    return chrono::steady_clock::now() + timeout;
+}
+
+// ==============================
+// SocialNetworkExecutor Implementation
+// ==============================
+
+SocialNetworkExecutor::SocialNetworkExecutor(SocialNetwork &network, const Options &options)
+    : network(network), options(options), queryQueue(options.queueCapacity), writeQueue(options.queueCapacity),
+      activeReaders(0), writerActive(false), writerWaiting(false)
+{
+    size_t workerCount = options.workers;
+    if (workerCount == 0)
+        workerCount = max(1u, thread::hardware_concurrency());
+
+    for (size_t i = 0; i < workerCount; i++)
+    {
+        workers.push_back(thread(&SocialNetworkExecutor::workerLoop, this));
+    }
+    writer = thread(&SocialNetworkExecutor::writerLoop, this);
+}
+
+SocialNetworkExecutor::~SocialNetworkExecutor()
+{
+    queryQueue.close();
+    writeQueue.close();
+    for (size_t i = 0; i < workers.size(); i++)
+    {
+        workers[i].join();
+    }
+    writer.join();
+}
+
+void SocialNetworkExecutor::workerLoop()
+{
+    Task task;
+    while (queryQueue.pop(task))
+    {
+        task();
+    }
+}
+
+void SocialNetworkExecutor::writerLoop()
+{
+    Task task;
+    while (writeQueue.pop(task))
+    {
+        task();
+    }
+}
+
+bool SocialNetworkExecutor::submit(BoundedQueue<Task> &queue, Task task)
+{
+    chrono::milliseconds wait(0);
+    if (options.backpressure == BLOCK)
+        wait = options.submitTimeout.count() > 0 ? options.submitTimeout : chrono::milliseconds(-1);
+    return queue.push(std::move(task), wait);
+}
+
+template <class R>
+future<R> SocialNetworkExecutor::submitQuery(function<R()> query, chrono::steady_clock::time_point deadline)
+{
+    shared_ptr<promise<R>> result = make_shared<promise<R>>();
+    future<R> answer = result->get_future();
+
+    Task task = [this, result, query, deadline]() mutable
+    {
+        // Requests that expired while queued are dropped without touching the network
+        if (chrono::steady_clock::now() >= deadline)
+        {
+            result->set_exception(make_exception_ptr(DeadlineExceededError()));
+            return;
+        }
+
+        beginRead();
+        try
+        {
+            fulfill(*result, query);
+        }
+        catch (...)
+        {
+            result->set_exception(current_exception());
+        }
+        endRead();
+    };
+
+    if (!submit(queryQueue, task))
+        result->set_exception(make_exception_ptr(QueueFullError()));
+    return answer;
+}
+
+template <class R>
+future<R> SocialNetworkExecutor::submitWrite(function<R()> mutation)
+{
+    shared_ptr<promise<R>> result = make_shared<promise<R>>();
+    future<R> answer = result->get_future();
+
+    Task task = [this, result, mutation]() mutable
+    {
+        beginWrite();
+        try
+        {
+            fulfill(*result, mutation);
+        }
+        catch (...)
+        {
+            result->set_exception(current_exception());
+        }
+        endWrite();
+    };
+
+    if (!submit(writeQueue, task))
+        result->set_exception(make_exception_ptr(QueueFullError()));
+    return answer;
+}
+
+future<vector<string>> SocialNetworkExecutor::shortestPath(const string &begin, const string &finish, chrono::milliseconds timeout)
+{
+    chrono::steady_clock::time_point deadline = deadlineAfter(timeout);
+    SocialNetwork &graph = network;
+    function<vector<string>()> query = [&graph, begin, finish, deadline]()
+    {
+        bool timedOut;
+        vector<string> path = namesOf(graph.shortestPath(begin, finish, deadline, &timedOut));
+        if (timedOut)
+            throw DeadlineExceededError();
+        return path;
+    };
+    return submitQuery(query, deadline);
+}
+
+future<vector<string>> SocialNetworkExecutor::topKPeople(const string &person, int k, SocialNetwork::RecommendationPolicy policy, chrono::milliseconds timeout)
+{
+    SocialNetwork &graph = network;
+    function<vector<string>()> query = [&graph, person, k, policy]()
+    {
+        return namesOf(graph.topKPeople(person, k, policy));
+    };
+    return submitQuery(query, deadlineAfter(timeout));
+}
+
+future<bool> SocialNetworkExecutor::areFriends(const string &personA, const string &personB)
+{
+    SocialNetwork &graph = network;
+    function<bool()> query = [&graph, personA, personB]()
+    {
+        return graph.areFriends(personA, personB);
+    };
+    return submitQuery(query, chrono::steady_clock::time_point::max());
+}
+
+future<void> SocialNetworkExecutor::addPerson(const string &person)
+{
+    SocialNetwork &graph = network;
+    function<void()> mutation = [&graph, person]()
+    {
+        graph.addPerson(person);
+    };
+    return submitWrite(mutation);
+}
+
+future<void> SocialNetworkExecutor::addFriend(const string &personA, const string &personB)
+{
+    SocialNetwork &graph = network;
+    function<void()> mutation = [&graph, personA, personB]()
+    {
+        graph.addFriend(personA, personB);
+    };
+    return submitWrite(mutation);
+}
+
+future<void> SocialNetworkExecutor::unfriend(const string &personA, const string &personB)
+{
+    SocialNetwork &graph = network;
+    function<void()> mutation = [&graph, personA, personB]()
+    {
+        graph.unfriend(personA, personB);
+    };
+    return submitWrite(mutation);
+}
+
+future<bool> SocialNetworkExecutor::deletePerson(const string &person)
+{
+    SocialNetwork &graph = network;
+    function<bool()> mutation = [&graph, person]()
+    {
+        return graph.deletePerson(person);
+    };
+    return submitWrite(mutation);
+}
+
+size_t SocialNetworkExecutor::pendingQueries()
+{
+    return queryQueue.size();
+}
+
+// ==============================
+// Reader / Writer Coordination
+// ==============================
+
+void SocialNetworkExecutor::beginRead()
+{
+    unique_lock<mutex> guard(accessLock);
+    // Queries step aside for a waiting mutation so the writer lane cannot starve
+    accessReady.wait(guard, [this]()
+                     { return !writerActive && !writerWaiting; });
+    activeReaders++;
+}
+
+void SocialNetworkExecutor::endRead()
+{
+    lock_guard<mutex> guard(accessLock);
+    if (--activeReaders == 0)
+        accessReady.notify_all();
+}
+
+void SocialNetworkExecutor::beginWrite()
+{
+    unique_lock<mutex> guard(accessLock);
+    writerWaiting = true;
+    accessReady.wait(guard, [this]()
+                     { return activeReaders == 0 && !writerActive; });
+    writerWaiting = false;
+    writerActive = true;
+}
+
+void SocialNetworkExecutor::endWrite()
+{
+    lock_guard<mutex> guard(accessLock);
+    writerActive = false;
+    accessReady.notify_all();
+}
@@ -0,0 +1,304 @@
+#ifndef SOCIALNETWORKEXECUTOR_H
+#define SOCIALNETWORKEXECUTOR_H
+
+#include "SocialNetwork.h"
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+using namespace std;
+
+/**
+ * @brief Thrown through a future when a query is submitted while the queue is full
+ * and the executor is configured to reject rather than wait.
+ */
+class QueueFullError : public runtime_error
+{
+public:
+    QueueFullError() : runtime_error("request queue is full") {}
+};
+
+/**
+ * @brief Thrown through a future when a query's deadline passes before it completes.
+ */
+class DeadlineExceededError : public runtime_error
+{
+public:
+    DeadlineExceededError() : runtime_error("request deadline exceeded") {}
+};
+
+/**
+ * @brief Fixed-capacity multi-producer multi-consumer FIFO queue.
+ *
+ * Producers can wait for room, wait for a limited time, or give up immediately;
+ * consumers block until an item arrives. Once closed, pushes fail and pops drain
+ * what is left before failing.
+ */
+template <class T>
+class BoundedQueue
+{
+    mutex lock;                    ///< Guards every member below
+    condition_variable notEmpty;   ///< Signaled when an item is pushed or the queue closes
+    condition_variable notFull;    ///< Signaled when an item is popped or the queue closes
+    deque<T> items;                ///< Queued items, oldest first
+    size_t capacity;               ///< Maximum number of queued items
+    bool closed;                   ///< True once close() has been called
+
+public:
+    /**
+     * @brief Creates an empty queue.
+     * @param capacity Maximum number of items held at once.
+     */
+    explicit BoundedQueue(size_t capacity) : capacity(capacity), closed(false) {}
+
+    /**
+     * @brief Adds an item, waiting for room if the queue is full.
+     * @param item Item to add.
+     * @param wait How long to wait for room (zero = no waiting, negative = forever).
+     * @return False if the queue stayed full for the whole wait or was closed.
+     */
+    bool push(T item, chrono::milliseconds wait)
+    {
+        unique_lock<mutex> guard(lock);
+        auto hasRoom = [this]()
+        { return closed || items.size() < capacity; };
+        if (wait.count() < 0)
+            notFull.wait(guard, hasRoom);
+        else if (!notFull.wait_for(guard, wait, hasRoom))
+            return false;
+        if (closed)
+            return false;
+
+        items.push_back(std::move(item));
+        notEmpty.notify_one();
+        return true;
+    }
+
+    /**
+     * @brief Removes the oldest item, waiting until one is available.
+     * @param item Receives the item.
+     * @return False once the queue is closed and empty.
+     */
+    bool pop(T &item)
+    {
+        unique_lock<mutex> guard(lock);
+        notEmpty.wait(guard, [this]()
+                      { return closed || !items.empty(); });
+        if (items.empty())
+            return false;
+
+        item = std::move(items.front());
+        items.pop_front();
+        notFull.notify_one();
+        return true;
+    }
+
+    /**
+     * @brief Stops accepting items and wakes up every waiting producer and consumer.
+     */
+    void close()
+    {
+        lock_guard<mutex> guard(lock);
+        closed = true;
+        notEmpty.notify_all();
+        notFull.notify_all();
+    }
+
+    /**
+     * @brief Number of items currently queued.
+     */
+    size_t size()
+    {
+        lock_guard<mutex> guard(lock);
+        return items.size();
+    }
+};
+
+/**
+ * @brief Asynchronous front end that runs SocialNetwork requests off the caller's thread.
+ *
+ * Queries (paths, recommendations, friendship checks) go through a bounded queue to
+ * a fixed pool of worker threads that read the network concurrently. Mutations go
+ * through a second bounded queue to a single writer thread, which applies them one
+ * at a time while no query is running. Every submission returns a future.
+ *
+ * Requests are not ordered across the two lanes: to read your own write, wait on the
+ * write's future before submitting the query. Results carry names rather than nodes.
+ */
+class SocialNetworkExecutor
+{
+public:
+    /**
+     * @brief What a submission does when its queue is full.
+     */
+    enum BackpressurePolicy
+    {
+        BLOCK, ///< Wait for room (up to submitTimeout, if set), then fail with QueueFullError
+        REJECT ///< Fail immediately with QueueFullError
+    };
+
+    /**
+     * @brief Executor configuration.
+     */
+    struct Options
+    {
+        size_t workers;                     ///< Query worker threads (0 = one per hardware core)
+        size_t queueCapacity;               ///< Capacity of each of the query and write queues
+        BackpressurePolicy backpressure;    ///< Behavior when a queue is full
+        chrono::milliseconds submitTimeout; ///< Longest BLOCK wait for room (0 = no limit)
+
+        Options() : workers(0), queueCapacity(1024), backpressure(BLOCK), submitTimeout(0) {}
+    };
+
+    /**
+     * @brief Starts the worker pool and the writer thread.
+     * @param network Network to serve; it must outlive the executor and must not be
+     *                used directly while the executor is running.
+     * @param options Executor configuration.
+     */
+    SocialNetworkExecutor(SocialNetwork &network, const Options &options = Options());
+
+    /**
+     * @brief Stops accepting requests, finishes everything already queued, and joins the threads.
+     */
+    ~SocialNetworkExecutor();
+
+    SocialNetworkExecutor(const SocialNetworkExecutor &) = delete;
+    SocialNetworkExecutor &operator=(const SocialNetworkExecutor &) = delete;
+
+    /**
+     * @brief Queues a shortest-path query.
+     * @param begin Name of the starting person.
+     * @param finish Name of the destination person.
+     * @param timeout Time allowed from submission to completion (0 = none). If it runs
+     *                out, the BFS stops partway and the future throws DeadlineExceededError.
+     * @return Future holding the names along the path (empty if unreachable).
+     */
+    future<vector<string>> shortestPath(const string &begin, const string &finish, chrono::milliseconds timeout = chrono::milliseconds(0));
+
+    /**
+     * @brief Queues a friend recommendation query.
+     * @param person Name of the person to recommend for.
+     * @param k Number of recommendations.
+     * @param policy How candidates are scored.
+     * @param timeout Time allowed from submission to the start of the query (0 = none).
+     * @return Future holding the names of the recommended people.
+     */
+    future<vector<string>> topKPeople(const string &person, int k, SocialNetwork::RecommendationPolicy policy = SocialNetwork::MUTUAL_FRIENDS,
+                                      chrono::milliseconds timeout = chrono::milliseconds(0));
+
+    /**
+     * @brief Queues a friendship check.
+     * @param personA Name of the first person.
+     * @param personB Name of the second person.
+     * @return Future holding true if they are friends.
+     */
+    future<bool> areFriends(const string &personA, const string &personB);
+
+    /**
+     * @brief Queues the addition of a person on the writer lane.
+     * @param person Name of the person to add.
+     * @return Future that becomes ready once the person is added.
+     */
+    future<void> addPerson(const string &person);
+
+    /**
+     * @brief Queues a new friendship on the writer lane.
+     * @param personA Name of the first person.
+     * @param personB Name of the second person.
+     * @return Future that becomes ready once the friendship is recorded.
+     */
+    future<void> addFriend(const string &personA, const string &personB);
+
+    /**
+     * @brief Queues the removal of a friendship on the writer lane.
+     * @param personA Name of the first person.
+     * @param personB Name of the second person.
+     * @return Future that becomes ready once the friendship is removed.
+     */
+    future<void> unfriend(const string &personA, const string &personB);
+
+    /**
+     * @brief Queues the deletion of a person on the writer lane.
+     * @param person Name of the person to remove.
+     * @return Future holding true if the person was found and deleted.
+     */
+    future<bool> deletePerson(const string &person);
+
+    /**
+     * @brief Number of queries waiting for a worker.
+     */
+    size_t pendingQueries();
+
+private:
+    typedef function<void()> Task;
+
+    SocialNetwork &network; ///< Network being served
+    Options options;        ///< Executor configuration
+
+    BoundedQueue<Task> queryQueue; ///< Read-only requests, consumed by the worker pool
+    BoundedQueue<Task> writeQueue; ///< Mutations, consumed by the writer thread
+    vector<thread> workers;        ///< Query worker threads
+    thread writer;                 ///< Writer lane thread
+
+    mutex accessLock;               ///< Guards the reader/writer counters below
+    condition_variable accessReady; ///< Signaled when readers or the writer leave
+    int activeReaders;              ///< Queries currently reading the network
+    bool writerActive;              ///< True while a mutation is being applied
+    bool writerWaiting;             ///< True while a mutation waits for readers to leave
+
+    /**
+     * @brief Main loop of a query worker.
+     */
+    void workerLoop();
+
+    /**
+     * @brief Main loop of the writer thread.
+     */
+    void writerLoop();
+
+    /**
+     * @brief Pushes a task onto a queue, applying the backpressure policy.
+     * @return False if the task was not accepted.
+     */
+    bool submit(BoundedQueue<Task> &queue, Task task);
+
+    /**
+     * @brief Queues a read-only request and wires its result to a future.
+     * @param query Computes the result while holding shared access to the network.
+     * @param deadline Point after which the request fails with DeadlineExceededError.
+     */
+    template <class R>
+    future<R> submitQuery(function<R()> query, chrono::steady_clock::time_point deadline);
+
+    /**
+     * @brief Queues a mutation on the writer lane and wires its result to a future.
+     * @param mutation Applies the change while holding exclusive access to the network.
+     */
+    template <class R>
+    future<R> submitWrite(function<R()> mutation);
+
+    /**
+     * @brief Converts a path or recommendation list to names.
+     */
+    template <class NodeList>
+    static vector<string> namesOf(const NodeList &nodes);
+
+    /**
+     * @brief Computes a deadline from a submission timeout.
+     * @param timeout Allowed time (0 = no deadline).
+     */
+    static chrono::steady_clock::time_point deadlineAfter(chrono::milliseconds timeout);
+
+    void beginRead();  ///< Waits until no mutation is running or waiting, then registers a reader
+    void endRead();    ///< Unregisters a reader
+    void beginWrite(); ///< Waits until no query is running, then claims exclusive access
+    void endWrite();   ///< Releases exclusive access
+};
+
+#endif // SOCIALNETWORKEXECUTOR_H
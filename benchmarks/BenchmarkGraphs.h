@@ -0,0 +1,122 @@
+#ifndef BENCHMARKGRAPHS_H
+#define BENCHMARKGRAPHS_H
+
+#include "../SocialNetwork.h"
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @file BenchmarkGraphs.h
+ * @brief Shared helpers for the benchmark programs: synthetic graphs and a wall-clock timer.
+ */
+
+/**
+ * @brief Name given to the i-th generated person.
+ * @param i Index of the person.
+ * @return The person's name ("P0", "P1", ...).
+ */
+inline string benchmarkName(int i)
+{
+    return "P" + to_string(i);
+}
+
+/**
+ * @brief Generates the friendships of a power-law social network using preferential
+ * attachment (Barabasi-Albert).
+ *
+ * Each new person befriends edgesPerPerson existing people, picked with probability
+ * proportional to their current number of friends, which yields a few very popular
+ * people and a long tail of ordinary ones.
+ *
+ * @param people Number of people.
+ * @param edgesPerPerson Number of friendships created by each new person.
+ * @param seed Random seed, so runs are reproducible.
+ * @return Friendships as pairs of person indices, in creation order.
+ */
+inline vector<pair<int, int>> powerLawFriendships(int people, int edgesPerPerson, unsigned seed = 42)
+{
+    mt19937 rng(seed);
+    vector<int> endpoints; // every friendship contributes both of its people once
+    vector<pair<int, int>> friendships;
+    unordered_set<long long> created;
+
+    for (int i = 0; i < people; i++)
+    {
+        int links = min(i, edgesPerPerson);
+        for (int e = 0; e < links; e++)
+        {
+            int target;
+            if (endpoints.empty())
+            {
+                target = uniform_int_distribution<int>(0, i - 1)(rng);
+            }
+            else
+            {
+                target = endpoints[uniform_int_distribution<size_t>(0, endpoints.size() - 1)(rng)];
+            }
+            if (target == i || !created.insert((long long)i * people + target).second)
+                continue;
+            friendships.push_back(make_pair(i, target));
+            endpoints.push_back(i);
+            endpoints.push_back(target);
+        }
+    }
+    return friendships;
+}
+
+/**
+ * @brief Builds a power-law social network from powerLawFriendships.
+ * @param network Network to fill (expected to be empty).
+ * @param people Number of people to add.
+ * @param edgesPerPerson Number of friendships created by each new person.
+ * @param seed Random seed, so runs are reproducible.
+ */
+inline void buildPowerLawNetwork(SocialNetwork &network, int people, int edgesPerPerson, unsigned seed = 42)
+{
+    for (int i = 0; i < people; i++)
+    {
+        network.addPerson(benchmarkName(i));
+    }
+    vector<pair<int, int>> friendships = powerLawFriendships(people, edgesPerPerson, seed);
+    for (size_t i = 0; i < friendships.size(); i++)
+    {
+        network.addFriend(benchmarkName(friendships[i].first), benchmarkName(friendships[i].second));
+    }
+}
+
+/**
+ * @brief Simple wall-clock stopwatch.
+ */
+class BenchmarkTimer
+{
+    chrono::steady_clock::time_point start; ///< Time of construction or last reset
+
+public:
+    BenchmarkTimer() : start(chrono::steady_clock::now()) {}
+
+    /**
+     * @brief Restarts the stopwatch.
+     */
+    void reset()
+    {
+        start = chrono::steady_clock::now();
+    }
+
+    /**
+     * @brief Time elapsed since construction or the last reset.
+     * @return Elapsed time in milliseconds.
+     */
+    double elapsedMs() const
+    {
+        return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    }
+};
+
+#endif // BENCHMARKGRAPHS_H
@@ -0,0 +1,99 @@
+/**
+ * @file executor_benchmark.cpp
+ * @brief Load generator for SocialNetworkExecutor: throughput and tail latency.
+ *
+ * Closed-loop clients each submit a request, wait for its future, and repeat for a
+ * fixed duration. The mix is 80% shortest paths, 19% recommendations and 1%
+ * friendship changes on the writer lane, all with a deadline. The run is repeated at
+ * increasing client counts, reporting throughput, latency percentiles, and how many
+ * requests missed their deadline or were rejected by backpressure.
+ */
+
+#include "BenchmarkGraphs.h"
+#include "../SocialNetworkExecutor.h"
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+
+using namespace std;
+
+int main(int argc, char *argv[])
+{
+    int people = argc > 1 ? atoi(argv[1]) : 100000;
+    int seconds = argc > 2 ? atoi(argv[2]) : 2;
+    int timeoutMs = argc > 3 ? atoi(argv[3]) : 50;
+
+    SocialNetwork network;
+    buildPowerLawNetwork(network, people, 5);
+
+    SocialNetworkExecutor::Options options;
+    options.queueCapacity = 256;
+    SocialNetworkExecutor executor(network, options);
+
+    cout << "People: " << people << ", workers: " << max(1u, thread::hardware_concurrency())
+         << ", deadline: " << timeoutMs << " ms" << endl;
+    cout << "clients\tthroughput (req/s)\tcompleted (req/s)\tp50 (ms)\tp99 (ms)\tp99.9 (ms)\tmissed deadline\trejected" << endl;
+
+    for (int clients = 1; clients <= 64; clients *= 2)
+    {
+        atomic<bool> running(true);
+        atomic<long> missed(0), rejected(0);
+        vector<vector<double>> latencies(clients);
+        vector<thread> pool;
+
+        for (int c = 0; c < clients; c++)
+        {
+            pool.push_back(thread([&, c]()
+                                  {
+                mt19937 rng(c + 1);
+                uniform_int_distribution<int> pick(0, people - 1);
+                uniform_int_distribution<int> kind(0, 99);
+                while (running)
+                {
+                    string a = benchmarkName(pick(rng)), b = benchmarkName(pick(rng));
+                    int roll = kind(rng);
+                    BenchmarkTimer timer;
+                    try
+                    {
+                        if (roll < 80)
+                            executor.shortestPath(a, b, chrono::milliseconds(timeoutMs)).get();
+                        else if (roll < 99)
+                            executor.topKPeople(a, 10, SocialNetwork::MUTUAL_FRIENDS, chrono::milliseconds(timeoutMs)).get();
+                        else if (roll % 2 == 0)
+                            executor.addFriend(a, b).get();
+                        else
+                            executor.unfriend(a, b).get();
+                    }
+                    catch (const DeadlineExceededError &)
+                    {
+                        missed++;
+                    }
+                    catch (const QueueFullError &)
+                    {
+                        rejected++;
+                    }
+                    latencies[c].push_back(timer.elapsedMs());
+                } }));
+        }
+
+        this_thread::sleep_for(chrono::seconds(seconds));
+        running = false;
+        for (size_t i = 0; i < pool.size(); i++)
+            pool[i].join();
+
+        vector<double> all;
+        for (int c = 0; c < clients; c++)
+            all.insert(all.end(), latencies[c].begin(), latencies[c].end());
+        sort(all.begin(), all.end());
+        if (all.empty())
+            continue;
+
+        auto percentile = [&all](double p)
+        { return all[min(all.size() - 1, (size_t)(p * all.size()))]; };
+        cout << clients << "\t" << all.size() / (double)seconds << "\t\t\t"
+             << (all.size() - missed - rejected) / (double)seconds << "\t\t\t" << percentile(0.50) << "\t\t"
+             << percentile(0.99) << "\t\t" << percentile(0.999) << "\t\t" << missed << "\t\t" << rejected << endl;
+    }
+    return 0;
+}
@@ -0,0 +1,99 @@
+/**
+ * @file minhash_benchmark.cpp
+ * @brief Measures recall@K and latency of the sketch-based recommendations.
+ *
+ * A power-law network is extended with a few celebrities who befriend a large
+ * random set of fans. Each celebrity is given top-K recommendations both exactly
+ * and from the MinHash sketches at several sketch sizes. A recommendation counts as a hit if
+ * its exact mutual friend count reaches that of the K-th exact recommendation, so
+ * ties are not penalized.
+ */
+
+#include "BenchmarkGraphs.h"
+#include <cstdlib>
+#include <iostream>
+
+using namespace std;
+
+/**
+ * @brief Exact number of mutual friends, from the sorted 1-hop ID lists.
+ */
+int exactCommonFriends(const SocialNetwork &network, const vector<int> &friendsA, const string &personB)
+{
+    vector<int> friendsB = network.kHopNeighborhood(personB, 1);
+    vector<int> common;
+    set_intersection(friendsA.begin(), friendsA.end(), friendsB.begin(), friendsB.end(), back_inserter(common));
+    return common.size();
+}
+
+int main(int argc, char *argv[])
+{
+    int people = argc > 1 ? atoi(argv[1]) : 200000;
+    int fans = argc > 2 ? atoi(argv[2]) : 50000;
+    int celebrities = argc > 3 ? atoi(argv[3]) : 5;
+    int k = argc > 4 ? atoi(argv[4]) : 10;
+
+    SocialNetwork network;
+    buildPowerLawNetwork(network, people, 5);
+
+    mt19937 rng(11);
+    uniform_int_distribution<int> pick(0, people - 1);
+    vector<string> celebrityNames;
+    for (int c = 0; c < celebrities; c++)
+    {
+        celebrityNames.push_back("Celebrity" + to_string(c));
+        network.addPerson(celebrityNames[c]);
+        for (int f = 0; f < fans; f++)
+        {
+            network.addFriend(celebrityNames[c], benchmarkName(pick(rng)));
+        }
+    }
+
+    // Exact answers first (the approximate mode is off until the threshold is lowered)
+    vector<vector<int>> friendLists(celebrities);
+    vector<int> kthScore(celebrities, 0);
+    double exactMs = 0;
+    size_t totalDegree = 0;
+    for (int c = 0; c < celebrities; c++)
+    {
+        const string &celebrity = celebrityNames[c];
+        friendLists[c] = network.kHopNeighborhood(celebrity, 1);
+        totalDegree += friendLists[c].size();
+
+        BenchmarkTimer timer;
+        auto exact = network.topKPeople(celebrity, k);
+        exactMs += timer.elapsedMs();
+        if (!exact.empty())
+            kthScore[c] = exactCommonFriends(network, friendLists[c], exact.back().getName());
+    }
+
+    cout << "People: " << people << ", celebrities: " << celebrities << " (average "
+         << totalDegree / celebrities << " friends), K = " << k << endl;
+    cout << "exact topKPeople:      " << exactMs / celebrities << " ms per query" << endl;
+
+    size_t sketchSizes[] = {64, 256, 1024, 4096};
+    for (size_t s = 0; s < sizeof(sketchSizes) / sizeof(sketchSizes[0]); s++)
+    {
+        network.setApproximateRecommendations(sketchSizes[s], 0);
+
+        double approxMs = 0;
+        int hits = 0, expected = 0;
+        for (int c = 0; c < celebrities; c++)
+        {
+            BenchmarkTimer timer;
+            auto approx = network.topKPeople(celebrityNames[c], k);
+            approxMs += timer.elapsedMs();
+
+            expected += k;
+            for (size_t i = 0; i < approx.size(); i++)
+            {
+                if (exactCommonFriends(network, friendLists[c], approx[i].getName()) >= kthScore[c])
+                    hits++;
+            }
+        }
+
+        cout << "sketch size " << sketchSizes[s] << ":\t" << approxMs / celebrities << " ms per query, recall@"
+             << k << " = " << (double)hits / expected << endl;
+    }
+    return 0;
+}
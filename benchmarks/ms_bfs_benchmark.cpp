@@ -0,0 +1,67 @@
+/**
+ * @file ms_bfs_benchmark.cpp
+ * @brief Compares the batched multi-source BFS against running shortestPath in a loop.
+ *
+ * Builds a power-law network, issues the same set of (source, destination) queries
+ * through both APIs, checks that every path has the same length, and reports the
+ * time taken by each.
+ */
+
+#include "BenchmarkGraphs.h"
+#include <cstdlib>
+#include <iostream>
+
+using namespace std;
+
+int main(int argc, char *argv[])
+{
+    int people = argc > 1 ? atoi(argv[1]) : 20000;
+    int queryCount = argc > 2 ? atoi(argv[2]) : 512;
+
+    SocialNetwork network;
+    buildPowerLawNetwork(network, people, 4);
+
+    mt19937 rng(7);
+    uniform_int_distribution<int> pick(0, people - 1);
+    vector<pair<string, string>> queries;
+    for (int q = 0; q < queryCount; q++)
+    {
+        queries.push_back(make_pair(benchmarkName(pick(rng)), benchmarkName(pick(rng))));
+    }
+
+    BenchmarkTimer timer;
+    vector<size_t> loopLengths;
+    for (size_t q = 0; q < queries.size(); q++)
+    {
+        loopLengths.push_back(network.shortestPath(queries[q].first, queries[q].second).size());
+    }
+    double loopMs = timer.elapsedMs();
+
+    timer.reset();
+    auto batchPaths = network.shortestPaths(queries);
+    double batchMs = timer.elapsedMs();
+
+    for (size_t q = 0; q < queries.size(); q++)
+    {
+        if (batchPaths[q].size() != loopLengths[q])
+        {
+            cerr << "Mismatch on query " << q << ": " << queries[q].first << " -> " << queries[q].second << endl;
+            return 1;
+        }
+    }
+
+    timer.reset();
+    vector<string> sources;
+    for (size_t q = 0; q < queries.size(); q++)
+    {
+        sources.push_back(queries[q].first);
+    }
+    network.multiSourceDistances(sources);
+    double distancesMs = timer.elapsedMs();
+
+    cout << "People: " << people << ", queries: " << queryCount << endl;
+    cout << "shortestPath loop:     " << loopMs << " ms" << endl;
+    cout << "shortestPaths (batch): " << batchMs << " ms (" << loopMs / batchMs << "x)" << endl;
+    cout << "multiSourceDistances:  " << distancesMs << " ms" << endl;
+    return 0;
+}
@@ -0,0 +1,88 @@
+/**
+ * @file pagerank_benchmark.cpp
+ * @brief Measures influence (PageRank) iterations per second and incremental update cost.
+ *
+ * First, a cold update runs from uniform scores at 1, 2, 4, ... threads. Then batches
+ * of random friendship changes (plus one deletion per hundred changes) are applied,
+ * and a warm update starting from the previous scores is compared with a cold one on
+ * the same network: iterations, time, and how far apart their final scores are.
+ */
+
+#include "BenchmarkGraphs.h"
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+
+using namespace std;
+
+/**
+ * @brief Snapshot of everyone's influence score, indexed by generated person number.
+ */
+static vector<double> scoresOf(SocialNetwork &network, int people)
+{
+    vector<double> scores(people);
+    for (int i = 0; i < people; i++)
+    {
+        scores[i] = network.influence(benchmarkName(i));
+    }
+    return scores;
+}
+
+int main(int argc, char *argv[])
+{
+    int people = argc > 1 ? atoi(argv[1]) : 200000;
+    int edgesPerPerson = argc > 2 ? atoi(argv[2]) : 5;
+    unsigned maxThreads = max(1u, thread::hardware_concurrency());
+
+    SocialNetwork network;
+    buildPowerLawNetwork(network, people, edgesPerPerson);
+    size_t friendships = powerLawFriendships(people, edgesPerPerson).size();
+
+    cout << "People: " << people << ", friendships: " << friendships << endl;
+    cout << "threads\titerations\ttime (ms)\titerations/s\tfriendships pulled/s" << endl;
+    for (unsigned threads = 1; threads <= maxThreads; threads *= 2)
+    {
+        BenchmarkTimer timer;
+        SocialNetwork::InfluenceUpdate update = network.updateInfluence(threads, false);
+        double ms = timer.elapsedMs();
+        double perSecond = update.iterations * 1000.0 / ms;
+        cout << threads << "\t" << update.iterations << "\t\t" << ms << "\t\t" << perSecond << "\t\t" << perSecond * 2 * friendships << endl;
+    }
+
+    cout << "\nchanges\twarm iterations\twarm (ms)\tcold iterations\tcold (ms)\tL1 warm vs cold" << endl;
+    mt19937 rng(11);
+    uniform_int_distribution<int> pick(0, people - 1);
+    for (int batch = 10; batch <= 10000; batch *= 10)
+    {
+        network.updateInfluence(maxThreads);
+        for (int c = 0; c < batch; c++)
+        {
+            string a = benchmarkName(pick(rng)), b = benchmarkName(pick(rng));
+            if (c % 100 == 99)
+                network.deletePerson(a);
+            else if (c % 2 == 0)
+                network.addFriend(a, b);
+            else
+                network.unfriend(a, b);
+        }
+
+        BenchmarkTimer timer;
+        SocialNetwork::InfluenceUpdate warm = network.updateInfluence(maxThreads, true);
+        double warmMs = timer.elapsedMs();
+        vector<double> warmScores = scoresOf(network, people);
+
+        timer.reset();
+        SocialNetwork::InfluenceUpdate cold = network.updateInfluence(maxThreads, false);
+        double coldMs = timer.elapsedMs();
+        vector<double> coldScores = scoresOf(network, people);
+
+        double difference = 0.0;
+        for (int i = 0; i < people; i++)
+        {
+            difference += fabs(warmScores[i] - coldScores[i]);
+        }
+        cout << batch << "\t" << warm.iterations << "\t\t" << warmMs << "\t\t" << cold.iterations << "\t\t" << coldMs << "\t\t" << difference << endl;
+    }
+    return 0;
+}
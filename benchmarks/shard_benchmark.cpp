@@ -0,0 +1,99 @@
+/**
+ * @file shard_benchmark.cpp
+ * @brief Compares ShardedSocialNetwork running on 1 shard against N shards.
+ *
+ * The same power-law network is loaded into networks with 1, 2, 4, ... worker
+ * processes, and each answers the same random shortest-path and recommendation
+ * queries. The in-process SocialNetwork is timed on the same queries as a baseline
+ * for the cost of the message passing.
+ */
+
+#include "BenchmarkGraphs.h"
+#include "../ShardedSocialNetwork.h"
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+
+using namespace std;
+
+int main(int argc, char *argv[])
+{
+    int people = argc > 1 ? atoi(argv[1]) : 100000;
+    int queries = argc > 2 ? atoi(argv[2]) : 200;
+    int maxShards = argc > 3 ? atoi(argv[3]) : 8;
+
+    vector<string> names;
+    for (int i = 0; i < people; i++)
+    {
+        names.push_back(benchmarkName(i));
+    }
+    vector<pair<int, int>> edges = powerLawFriendships(people, 5);
+    vector<pair<string, string>> friendships;
+    for (size_t i = 0; i < edges.size(); i++)
+    {
+        friendships.push_back(make_pair(names[edges[i].first], names[edges[i].second]));
+    }
+
+    mt19937 rng(7);
+    uniform_int_distribution<int> pick(0, people - 1);
+    vector<pair<string, string>> pairs;
+    for (int q = 0; q < queries; q++)
+    {
+        pairs.push_back(make_pair(names[pick(rng)], names[pick(rng)]));
+    }
+
+    cout << "People: " << people << ", friendships: " << edges.size() << ", queries: " << queries
+         << ", cores: " << thread::hardware_concurrency() << endl;
+    cout << "shards\tload (ms)\tshortest path (ms/query)\ttop-10 (ms/query)\tpath hops" << endl;
+
+    {
+        SocialNetwork network;
+        BenchmarkTimer timer;
+        buildPowerLawNetwork(network, people, 5);
+        double loadMs = timer.elapsedMs();
+
+        size_t hops = 0;
+        timer.reset();
+        for (int q = 0; q < queries; q++)
+        {
+            hops += network.shortestPath(pairs[q].first, pairs[q].second).size();
+        }
+        double pathMs = timer.elapsedMs();
+
+        timer.reset();
+        for (int q = 0; q < queries; q++)
+        {
+            network.topKPeople(pairs[q].first, 10);
+        }
+        double topKMs = timer.elapsedMs();
+
+        cout << "in-process\t" << loadMs << "\t\t" << pathMs / queries << "\t\t\t" << topKMs / queries << "\t\t\t" << hops << endl;
+    }
+
+    for (int shardCount = 1; shardCount <= maxShards; shardCount *= 2)
+    {
+        ShardedSocialNetwork network(shardCount);
+        BenchmarkTimer timer;
+        network.addPeople(names);
+        network.addFriends(friendships);
+        double loadMs = timer.elapsedMs();
+
+        size_t hops = 0;
+        timer.reset();
+        for (int q = 0; q < queries; q++)
+        {
+            hops += network.shortestPath(pairs[q].first, pairs[q].second).size();
+        }
+        double pathMs = timer.elapsedMs();
+
+        timer.reset();
+        for (int q = 0; q < queries; q++)
+        {
+            network.topKPeople(pairs[q].first, 10);
+        }
+        double topKMs = timer.elapsedMs();
+
+        cout << shardCount << "\t" << loadMs << "\t\t" << pathMs / queries << "\t\t\t" << topKMs / queries << "\t\t\t" << hops << endl;
+    }
+    return 0;
+}
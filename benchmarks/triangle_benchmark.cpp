@@ -0,0 +1,70 @@
+/**
+ * @file triangle_benchmark.cpp
+ * @brief Measures triangle counting and clustering coefficients on power-law networks.
+ *
+ * Checks the oriented count against a brute-force count over friend pairs on a small
+ * network, then times triangleStatistics on a larger one with increasing thread counts.
+ */
+
+#include "BenchmarkGraphs.h"
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+
+using namespace std;
+
+/**
+ * @brief Counts triangles by checking every pair of friends of every person.
+ * @param network Network to inspect.
+ * @param people Number of people in the network.
+ * @return Number of distinct triangles.
+ */
+long long bruteForceTriangles(const SocialNetwork &network, int people)
+{
+    long long corners = 0;
+    for (int v = 0; v < people; v++)
+    {
+        vector<int> friends = network.kHopNeighborhood(benchmarkName(v), 1);
+        for (size_t i = 0; i < friends.size(); i++)
+            for (size_t j = i + 1; j < friends.size(); j++)
+                if (network.areFriends(network.personName(friends[i]), network.personName(friends[j])))
+                    corners++;
+    }
+    return corners / 3;
+}
+
+int main(int argc, char *argv[])
+{
+    int people = argc > 1 ? atoi(argv[1]) : 200000;
+    int edgesPerPerson = argc > 2 ? atoi(argv[2]) : 8;
+
+    SocialNetwork small;
+    buildPowerLawNetwork(small, 2000, 6);
+    long long expected = bruteForceTriangles(small, 2000);
+    long long actual = small.triangleStatistics().totalTriangles;
+    if (expected != actual)
+    {
+        cerr << "Triangle count mismatch: expected " << expected << ", got " << actual << endl;
+        return 1;
+    }
+
+    SocialNetwork network;
+    buildPowerLawNetwork(network, people, edgesPerPerson);
+    cout << "People: " << people << ", friendships per new person: " << edgesPerPerson << endl;
+
+    unsigned maxThreads = max(1u, thread::hardware_concurrency());
+    double singleMs = 0;
+    for (unsigned threads = 1; threads <= maxThreads; threads *= 2)
+    {
+        BenchmarkTimer timer;
+        SocialNetwork::TriangleStatistics stats = network.triangleStatistics(threads);
+        double ms = timer.elapsedMs();
+        if (threads == 1)
+            singleMs = ms;
+
+        cout << threads << " thread(s): " << ms << " ms (" << singleMs / ms << "x), "
+             << stats.totalTriangles << " triangles, average clustering " << stats.averageClustering
+             << ", transitivity " << stats.globalClustering << endl;
+    }
+    return 0;
+}
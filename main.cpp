@@ -8,10 +8,15 @@
  * - Manage friendships between people
  * - Find paths between people
  * - Get friend recommendations
+ * - Explore everyone within k hops of a person
+ * - Inspect how tightly knit a person's friend group is
+ * - Rank people by influence
  * - View the entire network structure
+ * - Save the network to, and load it from, edge list files
  */
 
 #include "SocialNetwork.h"
+#include <fstream>
 #include <iostream>
 #include <string>
 #include <vector>
@@ -27,7 +32,11 @@ using namespace std;
  * - Managing friendships
  * - Finding paths
  * - Getting recommendations
+ * - Exploring k-hop neighborhoods
+ * - Computing clustering coefficients
+ * - Ranking the most influential people
  * - Viewing the network
+ * - Exporting and importing the network
  */
 void displayMenu()
 {
@@ -41,6 +50,11 @@ void displayMenu()
     cout << "7. Display Shortest Path Avoiding Specific People" << endl;
     cout << "8. Display Top K Friend Recommendations" << endl;
     cout << "9. Display Entire Social Network" << endl;
+    cout << "10. Display People Within K Hops" << endl;
+    cout << "11. Display Clustering Coefficient of a Person" << endl;
+    cout << "12. Export Social Network to File" << endl;
+    cout << "13. Import Social Network from Edge List File" << endl;
+    cout << "14. Display Top K Most Influential People" << endl;
     cout << "0. Exit" << endl;
     cout << "===============================" << endl;
     cout << "Enter your choice: ";
@@ -178,10 +192,19 @@ int main()
             cout << "Enter number of recommendations (K): ";
             int k;
             cin >> k;
+            cout << "Scoring (0 = Mutual Friends, 1 = Adamic-Adar, 2 = Resource Allocation, 3 = Jaccard): ";
+            int policy;
+            cin >> policy;
             cin.ignore();
 
+            if (policy < SocialNetwork::MUTUAL_FRIENDS || policy > SocialNetwork::JACCARD)
+            {
+                cout << "Invalid scoring, using mutual friends." << endl;
+                policy = SocialNetwork::MUTUAL_FRIENDS;
+            }
+
             cout << "Top " << k << " recommendations for " << personA << ": ";
-            socialNetwork.displayTopKPeople(personA, k);
+            socialNetwork.displayTopKPeople(personA, k, (SocialNetwork::RecommendationPolicy)policy);
             cout << endl;
             break;
 
@@ -191,6 +214,88 @@ int main()
             cout << "-------------------------------" << endl;
             break;
 
+        case 10: // Display People Within K Hops
+        {
+            cout << "Enter person's name: ";
+            getline(cin, personA);
+            cout << "Enter number of hops (K): ";
+            int hops;
+            cin >> hops;
+            cin.ignore();
+
+            cout << "People within " << hops << " hops of " << personA << ": ";
+            socialNetwork.displayKHopNeighborhood(personA, hops);
+        }
+        break;
+
+        case 11: // Display Clustering Coefficient of a Person
+            cout << "Enter person's name: ";
+            getline(cin, personA);
+
+            cout << "Clustering for " << personA << ": ";
+            socialNetwork.displayClusteringCoefficient(personA);
+            cout << endl;
+            break;
+
+        case 12: // Export Social Network to File
+        {
+            cout << "Enter file name: ";
+            getline(cin, personA);
+            cout << "Format (0 = Edge List Text, 1 = CSV, 2 = Graphviz DOT): ";
+            int format;
+            cin >> format;
+            cin.ignore();
+
+            if (format < SocialNetwork::TEXT_FORMAT || format > SocialNetwork::DOT_FORMAT)
+            {
+                cout << "Invalid format." << endl;
+                break;
+            }
+
+            ofstream file(personA.c_str());
+            if (!file)
+            {
+                cout << "Could not open " << personA << " for writing." << endl;
+                break;
+            }
+            socialNetwork.exportNetwork(file, (SocialNetwork::ExportFormat)format);
+            cout << "Network exported to " << personA << "." << endl;
+        }
+        break;
+
+        case 13: // Import Social Network from Edge List File
+        {
+            cout << "Enter file name: ";
+            getline(cin, personA);
+
+            ifstream file(personA.c_str());
+            if (!file)
+            {
+                cout << "Could not open " << personA << " for reading." << endl;
+                break;
+            }
+            int malformed = socialNetwork.importNetwork(file);
+            cout << "Network imported from " << personA << "." << endl;
+            if (malformed > 0)
+            {
+                cout << malformed << " malformed line(s) were skipped." << endl;
+            }
+        }
+        break;
+
+        case 14: // Display Top K Most Influential People
+        {
+            cout << "Enter number of people (K): ";
+            int count;
+            cin >> count;
+            cin.ignore();
+
+            cout << "Top " << count << " most influential people: ";
+            socialNetwork.displayTopInfluencers(count);
+            cout << endl;
+        }
+        break;
+
         case 0: // Exit
             cout << "Exiting Social Network Manager. Goodbye!" << endl;
             break;